@@ -0,0 +1,115 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "DataRefRegistry.h"
+#include "ParsedCondition.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class ActionType : uint8_t {
+    None,           // Unknown or invalid action; runs nothing but still obeys continue-to-next-action
+    Command,
+    DataRefSet,
+    DataRefAdjust,
+    Sound,
+    Sequence,
+    Hold,           // Command held down from press until release
+    Repeat          // Inner action run on press, then at a fixed rate until release
+};
+
+enum class LimitType : uint8_t {
+    None,
+    Clamp,
+    Wrap
+};
+
+struct AccelerationStep {
+    float velocity = 0.0f;
+    float multiplier = 1.0f;
+};
+
+struct SequenceProgram;
+
+/**
+ * @brief One action of an event, compiled from its JSON by EventProcessor::PrepareConfig.
+ */
+struct CompiledAction {
+    ActionType type = ActionType::None;
+    std::string value;              // Command or dataref as written in the config; full path for sounds
+
+    void* command = nullptr;        // Command handle; nullptr until the SDK lookup succeeds
+    DataRefId dataRef = 0;          // Dataref actions; handle and type flags live in the registry
+    int index = -1;                 // Array element, or -1 for a scalar dataref
+    SoundId sound = kNoSound;       // Sound actions; loaded in the background when compiled
+
+    int sendCount = 1;
+    bool merge = false;             // Absorb into an identical command still waiting to run
+    float adjustment = 0.0f;
+    LimitType limitType = LimitType::None;
+    float minValue = 0.0f;
+    float maxValue = 0.0f;
+    std::vector<AccelerationStep> acceleration; // Ascending velocity, one step per threshold
+
+    // Steps of a "sequence" action; shared with any running instance so a
+    // config reload cannot free it mid-run
+    std::shared_ptr<SequenceProgram> sequence;
+
+    // "repeat" actions: the action to repeat, shared with the running repeat
+    std::shared_ptr<CompiledAction> repeated;
+    float repeatDelay = 0.0f;       // Seconds from the press to the first repeat
+    float repeatInterval = 0.0f;    // Seconds between repeats
+
+    bool continueToNext = false;
+    ConditionTree conditions;       // Empty if the action always runs
+};
+
+/**
+ * @brief One step of a "sequence" action.
+ */
+struct SequenceStep {
+    enum class Kind : uint8_t {
+        Action,     // Run `action` (if its conditions are met) and go straight on
+        Wait,       // Pause for `seconds`
+        WaitUntil   // Pause until `condition` is true; cancel the sequence after `seconds` if non-zero
+    };
+
+    Kind kind = Kind::Action;
+    CompiledAction action;
+    float seconds = 0.0f;
+    ConditionTree condition;
+};
+
+/**
+ * @brief The steps of a "sequence" action.
+ */
+struct SequenceProgram {
+    std::vector<SequenceStep> steps;
+    std::vector<ArrayWindow> arrayWindows;  // Array elements the step conditions read, grouped for ranged reads
+};
+
+using ActionPlan = std::vector<CompiledAction>;
+
+/**
+ * @brief The actions of one event and the array reads their conditions share.
+ */
+struct PreparedPlan {
+    ActionPlan actions;
+    std::vector<ArrayWindow> arrayWindows;
+};
@@ -0,0 +1,94 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "CommandScheduler.h"
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+
+void CommandScheduler::SetBudget(int commandsPerFrame, float timeSliceMs)
+{
+    m_commandsPerFrame = std::max(commandsPerFrame, 1);
+    m_timeSliceMs = std::max(timeSliceMs, 0.0f);
+}
+
+int CommandScheduler::Enqueue(void* command, int times, CommandPriority priority, bool merge)
+{
+    if (!command || times <= 0) return 0;
+
+    auto& queue = m_queues[static_cast<size_t>(priority)];
+    // The queue holds at most kMaxPendingCommands entries, so a linear search is cheap
+    if (merge && std::any_of(queue.begin(), queue.end(), [command](const Entry& entry) {
+            return entry.command == command && entry.merge;
+        })) {
+        m_stats.merged += static_cast<uint64_t>(times);
+        IFR1_LOG_VERBOSE(m_sdk, "Merged {} run(s) into pending command", times);
+        return 0;
+    }
+
+    const int accepted = static_cast<int>(std::min<size_t>(static_cast<size_t>(times), kMaxPendingCommands - m_pending));
+    if (accepted < times) {
+        m_stats.dropped += static_cast<uint64_t>(times - accepted);
+        IFR1_LOG_VERBOSE(m_sdk, "Command queue full, discarding {} command(s)", times - accepted);
+    }
+    if (accepted == 0) return 0;
+
+    if (!queue.empty() && queue.back().command == command && queue.back().merge == merge) {
+        queue.back().remaining += accepted;
+    } else {
+        queue.push_back({command, accepted, merge});
+    }
+    m_pending += static_cast<size_t>(accepted);
+    m_stats.maxQueueDepth = std::max(m_stats.maxQueueDepth, m_pending);
+    return accepted;
+}
+
+void CommandScheduler::RunFrame()
+{
+    if (m_pending == 0) return;
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto timeSlice = std::chrono::duration<float, std::milli>(m_timeSliceMs);
+    for (int run = 0; run < m_commandsPerFrame && m_pending > 0; ++run) {
+        // Always make progress: the time slice is only checked after the first command
+        if (run > 0 && std::chrono::steady_clock::now() - start >= timeSlice) break;
+
+        auto& queue = m_queues[static_cast<size_t>(CommandPriority::High)].empty()
+                          ? m_queues[static_cast<size_t>(CommandPriority::Normal)]
+                          : m_queues[static_cast<size_t>(CommandPriority::High)];
+        Entry& entry = queue.front();
+        void* command = entry.command;
+        if (--entry.remaining == 0) {
+            queue.pop_front();
+        }
+        --m_pending;
+        ++m_stats.executed;
+        m_sdk.CommandOnce(command);
+    }
+}
+
+void CommandScheduler::Clear()
+{
+    for (auto& queue : m_queues) queue.clear();
+    m_pending = 0;
+}
+
+CommandScheduler::Stats CommandScheduler::GetStats() const
+{
+    Stats stats = m_stats;
+    stats.queueDepth = m_pending;
+    return stats;
+}
@@ -0,0 +1,91 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+#include "XPlaneSDK.h"
+#include <array>
+#include <cstdint>
+#include <deque>
+
+enum class CommandPriority : uint8_t {
+    Normal = 0,     // Knob rotation
+    High            // Button presses; run before any queued knob ticks
+};
+
+/**
+ * @brief Runs queued X-Plane commands from the flight loop within a per-frame budget.
+ *
+ * Consecutive runs of the same command are stored as one entry with a
+ * repeat count, so a fast knob spin or a large send-count takes a single
+ * slot.  Each frame runs up to the command budget, stopping early once the
+ * time slice is used up; whatever is left carries over to the next frame.
+ */
+class CommandScheduler {
+public:
+    struct Stats {
+        size_t queueDepth = 0;      // Command runs waiting
+        size_t maxQueueDepth = 0;   // High-water mark of queueDepth
+        uint64_t executed = 0;
+        uint64_t merged = 0;        // Runs absorbed by an identical pending "merge" command
+        uint64_t dropped = 0;       // Runs discarded because the queue was full
+    };
+
+    static constexpr int kDefaultCommandsPerFrame = 8;
+    static constexpr float kDefaultTimeSliceMs = 2.0f;
+    static constexpr size_t kMaxPendingCommands = 64;
+
+    explicit CommandScheduler(IXPlaneSDK& sdk) : m_sdk(sdk) {}
+
+    /**
+     * @brief Sets how much work RunFrame() may do.
+     * @param commandsPerFrame Maximum commands per frame (at least 1).
+     * @param timeSliceMs Stop starting new commands once a frame has spent this long.
+     */
+    void SetBudget(int commandsPerFrame, float timeSliceMs);
+
+    /**
+     * @brief Queues a command to run `times` times.
+     * @param merge If the same "merge" command is already waiting anywhere in
+     *        its queue, absorb this request into it instead of running it again.
+     * @return Number of runs added to the queue.
+     */
+    int Enqueue(void* command, int times, CommandPriority priority, bool merge);
+
+    /**
+     * @brief Runs queued commands, highest priority first, within the budget.
+     * Should be called once per frame.
+     */
+    void RunFrame();
+
+    void Clear();
+
+    [[nodiscard]] Stats GetStats() const;
+
+private:
+    struct Entry {
+        void* command = nullptr;
+        int remaining = 0;
+        bool merge = false;
+    };
+
+    IXPlaneSDK& m_sdk;
+    int m_commandsPerFrame = kDefaultCommandsPerFrame;
+    float m_timeSliceMs = kDefaultTimeSliceMs;
+    // Indexed by CommandPriority
+    std::array<std::deque<Entry>, 2> m_queues;
+    size_t m_pending = 0;
+    Stats m_stats;
+};
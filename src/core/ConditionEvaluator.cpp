@@ -17,130 +17,291 @@
 #include "ConditionEvaluator.h"
 #include "DataRefUtils.h"
 #include "Logger.h"
-#include "ParsedCondition.h"
-#include <string>
-#include <nlohmann/json.hpp>
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <format>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
 
-bool ConditionEvaluator::EvaluateCondition(const nlohmann::json& condition, bool verbose) const {
-    if (!condition.contains("dataref")) return false;
+namespace {
 
-    std::string rawDrName = condition["dataref"];
-    auto info = ::ParseDataRef(rawDrName);
-    void* drRef = m_sdk.FindDataRef(info.name.c_str());
-    if (!drRef) {
-        IFR1_LOG_VERBOSE(m_sdk, "Condition failed - DataRef not found: {}", info.name);
-        return false;
+// Longest string a "string-equals" test can match
+constexpr size_t kMaxStringLength = 256;
+
+// Byte datarefs are zero-padded C strings
+std::string_view ReadText(IXPlaneSDK& sdk, void* drRef, std::array<char, kMaxStringLength>& buffer) {
+    int bytes = sdk.GetDatab(drRef, buffer.data(), 0, static_cast<int>(buffer.size()));
+    return {buffer.data(), bytes > 0 ? strnlen(buffer.data(), static_cast<size_t>(bytes)) : 0};
+}
+
+uint32_t PushNode(ConditionTree& tree, ConditionNode node) {
+    tree.nodes.push_back(std::move(node));
+    tree.nodes.back().end = static_cast<uint32_t>(tree.nodes.size());
+    return static_cast<uint32_t>(tree.nodes.size() - 1);
+}
+
+uint32_t PushNode(ConditionTree& tree, ConditionOp op) {
+    ConditionNode node;
+    node.op = op;
+    return PushNode(tree, std::move(node));
+}
+
+// Only called when verbose logging is on
+std::string Describe(const ConditionNode& node) {
+    switch (node.op) {
+    case ConditionOp::Range: return std::format("range [{}, {}]", node.operand, node.maxVal);
+    case ConditionOp::Bit: return std::format("bit {} set", node.bit);
+    case ConditionOp::Equal: return std::format("== {}", node.operand);
+    case ConditionOp::NotEqual: return std::format("!= {}", node.operand);
+    case ConditionOp::Less: return std::format("< {}", node.operand);
+    case ConditionOp::Greater: return std::format("> {}", node.operand);
+    case ConditionOp::StringEquals: return std::format("\"{}\"", node.text);
+    default: return "unknown test";
     }
+}
 
-    int types = m_sdk.GetDataRefTypes(drRef);
-    double val = 0.0;
-    if (info.index != -1) {
-        if (types & static_cast<int>(DataRefType::IntArray)) {
-            val = static_cast<double>(m_sdk.GetDataiArray(drRef, info.index));
+} // namespace
+
+ConditionTree ConditionEvaluator::CompileCondition(const nlohmann::json& condition, bool resolve) {
+    ConditionTree tree;
+    CompileNode(condition, tree, resolve);
+    return tree;
+}
+
+ConditionTree ConditionEvaluator::CompileConditions(const nlohmann::json& actionConfig, bool resolve) {
+    ConditionTree tree;
+    if (actionConfig.contains("conditions")) {
+        const auto& conditions = actionConfig["conditions"];
+        if (conditions.is_array()) {
+            CompileGroup(ConditionOp::All, conditions, tree, resolve);
         } else {
-            val = static_cast<double>(m_sdk.GetDatafArray(drRef, info.index));
+            CompileNode(conditions, tree, resolve);
         }
-    } else {
-        if (types & static_cast<int>(DataRefType::Int)) {
-            val = static_cast<double>(m_sdk.GetDatai(drRef));
+    } else if (actionConfig.contains("condition")) {
+        CompileNode(actionConfig["condition"], tree, resolve);
+    }
+    return tree;
+}
+
+void ConditionEvaluator::CompileNode(const nlohmann::json& condition, ConditionTree& tree, bool resolve) {
+    if (!condition.is_object()) {
+        PushNode(tree, ConditionOp::Never);
+    } else if (condition.contains("all")) {
+        CompileGroup(ConditionOp::All, condition["all"], tree, resolve);
+    } else if (condition.contains("any")) {
+        CompileGroup(ConditionOp::Any, condition["any"], tree, resolve);
+    } else if (condition.contains("not")) {
+        const auto& negated = condition["not"];
+        if (!negated.is_object() && !negated.is_array()) {
+            PushNode(tree, ConditionOp::Never);
+            return;
+        }
+        const uint32_t at = PushNode(tree, ConditionOp::Not);
+        if (negated.is_array()) {
+            CompileGroup(ConditionOp::All, negated, tree, resolve);
         } else {
-            val = static_cast<double>(m_sdk.GetDataf(drRef));
+            CompileNode(negated, tree, resolve);
         }
+        tree.nodes[at].end = static_cast<uint32_t>(tree.nodes.size());
+    } else {
+        CompileDataRefTests(condition, tree, resolve);
     }
+}
 
-    bool result = false;
+void ConditionEvaluator::CompileGroup(ConditionOp op, const nlohmann::json& children, ConditionTree& tree,
+                                      bool resolve) {
+    const uint32_t at = PushNode(tree, op);
+    if (children.is_array()) {
+        for (const auto& child : children) CompileNode(child, tree, resolve);
+    } else {
+        CompileNode(children, tree, resolve);
+    }
+    tree.nodes[at].end = static_cast<uint32_t>(tree.nodes.size());
+}
+
+void ConditionEvaluator::CompileDataRefTests(const nlohmann::json& condition, ConditionTree& tree, bool resolve) {
+    if (!condition.contains("dataref") || !condition["dataref"].is_string()) {
+        PushNode(tree, ConditionOp::Never);
+        return;
+    }
+
+    ConditionNode leaf;
+    leaf.rawName = condition["dataref"].get<std::string>();
+    auto info = ::ParseDataRef(leaf.rawName);
+    leaf.dataRef = m_dataRefs.Intern(info.name);
+    leaf.index = info.index;
+    if (resolve) m_dataRefs.Resolve(leaf.dataRef);
+
+    // Every test given for the dataref must pass
+    std::vector<ConditionNode> tests;
+    auto addTest = [&](ConditionOp op) -> ConditionNode& {
+        tests.push_back(leaf);
+        tests.back().op = op;
+        return tests.back();
+    };
 
     if (condition.contains("bit")) {
         int bit = condition["bit"].get<int>();
-        result = bit >= 0 && (static_cast<unsigned int>(val) & (1u << bit)) != 0;
-    } else if (condition.contains("min") && condition.contains("max")) {
-        double minVal = condition["min"].get<double>();
-        double maxVal = condition["max"].get<double>();
-        result = (val >= minVal && val <= maxVal);
+        // A bit outside the 32-bit value can never be set
+        addTest(bit >= 0 && bit < 32 ? ConditionOp::Bit : ConditionOp::Never).bit = bit;
+    }
+    if (condition.contains("min") && condition.contains("max")) {
+        auto& test = addTest(ConditionOp::Range);
+        test.operand = condition["min"].get<double>();
+        test.maxVal = condition["max"].get<double>();
+    }
+    static constexpr std::array<std::pair<const char*, ConditionOp>, 4> kComparisons = {{
+        {"eq", ConditionOp::Equal}, {"ne", ConditionOp::NotEqual}, {"lt", ConditionOp::Less}, {"gt", ConditionOp::Greater}
+    }};
+    for (const auto& [key, op] : kComparisons) {
+        if (condition.contains(key)) addTest(op).operand = condition[key].get<double>();
+    }
+    if (condition.contains("string-equals")) {
+        auto text = condition["string-equals"].get<std::string>();
+        auto& test = addTest(text.size() < kMaxStringLength ? ConditionOp::StringEquals : ConditionOp::Never);
+        test.text = std::move(text);
     }
 
-    // Fallback for logging instead of std::format since it might not be supported in older compilers
-    std::string testDescription;
-    if (condition.contains("bit")) {
-        testDescription = "bit " + std::to_string(condition["bit"].get<int>()) + " set";
-    } else if (condition.contains("min") && condition.contains("max")) {
-        testDescription = "range [" + std::to_string(condition["min"].get<double>()) + ", " + std::to_string(condition["max"].get<double>()) + "]";
+    if (tests.empty()) {
+        // A dataref with nothing to test against never matches
+        leaf.op = ConditionOp::Never;
+        PushNode(tree, std::move(leaf));
+    } else if (tests.size() == 1) {
+        PushNode(tree, std::move(tests.front()));
     } else {
-        testDescription = "unknown test";
+        const uint32_t at = PushNode(tree, ConditionOp::All);
+        for (auto& test : tests) PushNode(tree, std::move(test));
+        tree.nodes[at].end = static_cast<uint32_t>(tree.nodes.size());
     }
+}
 
-    IFR1_LOG_VERBOSE_IF(m_sdk, verbose, "Testing {} (value: {}) against {} -> {}", rawDrName, val,
-        testDescription,
-        result ? "TRUE" : "FALSE");
+bool ConditionEvaluator::Evaluate(const ConditionTree& tree, bool verbose) const {
+    return tree.empty() || EvaluateNode(tree, 0, verbose);
+}
 
-    return result;
+bool ConditionEvaluator::EvaluateNode(const ConditionTree& tree, uint32_t nodeIndex, bool verbose) const {
+    const ConditionNode& node = tree.nodes[nodeIndex];
+    switch (node.op) {
+    case ConditionOp::Never:
+        return false;
+    case ConditionOp::All:
+        for (uint32_t child = nodeIndex + 1; child < node.end; child = tree.nodes[child].end) {
+            if (!EvaluateNode(tree, child, verbose)) return false;
+        }
+        return true;
+    case ConditionOp::Any:
+        for (uint32_t child = nodeIndex + 1; child < node.end; child = tree.nodes[child].end) {
+            if (EvaluateNode(tree, child, verbose)) return true;
+        }
+        return false;
+    case ConditionOp::Not:
+        return !EvaluateNode(tree, nodeIndex + 1, verbose);
+    default:
+        return EvaluateLeaf(node, verbose);
+    }
 }
 
-bool ConditionEvaluator::EvaluateParsedCondition(const ParsedCondition& condition, bool verbose) const {
-    if (!condition.drRef) {
-        IFR1_LOG_VERBOSE(m_sdk, "Condition failed - DataRef not found: {}", condition.rawName);
+bool ConditionEvaluator::EvaluateLeaf(const ConditionNode& node, bool verbose) const {
+    void* drRef = m_dataRefs.Resolve(node.dataRef);
+    if (!drRef) {
+        IFR1_LOG_VERBOSE(m_sdk, "Condition failed - DataRef not found: {}", node.rawName);
         return false;
     }
 
-    int types = m_sdk.GetDataRefTypes(condition.drRef);
-    double val = 0.0;
-    if (condition.index != -1) {
-        if (types & static_cast<int>(DataRefType::IntArray)) {
-            val = static_cast<double>(m_sdk.GetDataiArray(condition.drRef, condition.index));
-        } else {
-            val = static_cast<double>(m_sdk.GetDatafArray(condition.drRef, condition.index));
-        }
-    } else {
-        if (types & static_cast<int>(DataRefType::Int)) {
-            val = static_cast<double>(m_sdk.GetDatai(condition.drRef));
-        } else {
-            val = static_cast<double>(m_sdk.GetDataf(condition.drRef));
-        }
+    if (node.op == ConditionOp::StringEquals) {
+        std::array<char, kMaxStringLength> buffer{};
+        std::string_view value = ReadText(m_sdk, drRef, buffer);
+        bool result = value == node.text;
+        IFR1_LOG_VERBOSE_IF(m_sdk, verbose, "Testing {} (value: \"{}\") against {} -> {}", node.rawName, value,
+            Describe(node), result ? "TRUE" : "FALSE");
+        return result;
     }
 
-    bool result = false;
+    double val = m_dataRefs.ReadValue(node.dataRef, node.index);
 
-    if (condition.bit) {
-        result = *condition.bit >= 0 && (static_cast<unsigned int>(val) & (1u << *condition.bit)) != 0;
-    } else if (condition.minVal && condition.maxVal) {
-        result = (val >= *condition.minVal && val <= *condition.maxVal);
+    bool result = false;
+    switch (node.op) {
+    case ConditionOp::Range: result = val >= node.operand && val <= node.maxVal; break;
+    case ConditionOp::Bit: result = (static_cast<unsigned int>(val) & (1u << node.bit)) != 0; break;
+    case ConditionOp::Equal: result = val == node.operand; break;
+    case ConditionOp::NotEqual: result = val != node.operand; break;
+    case ConditionOp::Less: result = val < node.operand; break;
+    case ConditionOp::Greater: result = val > node.operand; break;
+    default: break;
     }
 
-    IFR1_LOG_VERBOSE_IF(m_sdk, verbose, "Testing {} (value: {}) against {} -> {}", condition.rawName, val,
-        [&] {
-            if (condition.bit) return std::string("bit ") + std::to_string(*condition.bit) + " set";
-            if (condition.minVal && condition.maxVal) return std::string("range [") + std::to_string(*condition.minVal) + ", " + std::to_string(*condition.maxVal) + "]";
-            return std::string("unknown test");
-        }(),
-        result ? "TRUE" : "FALSE");
+    IFR1_LOG_VERBOSE_IF(m_sdk, verbose, "Testing {} (value: {}) against {} -> {}", node.rawName, val,
+        Describe(node), result ? "TRUE" : "FALSE");
 
     return result;
 }
 
-bool ConditionEvaluator::EvaluateConditions(const nlohmann::json& actionConfig, bool verbose) const {
-    // If there is no "conditions" or "condition" key, it's always true (default action)
-    if (!actionConfig.contains("conditions") && !actionConfig.contains("condition")) {
-        IFR1_LOG_VERBOSE(m_sdk, "No conditions for this action, assuming TRUE");
-        return true;
+void ConditionEvaluator::CollectDependencies(const ConditionTree& tree, std::vector<ConditionDependency>& out) {
+    for (const auto& node : tree.nodes) {
+        switch (node.op) {
+        case ConditionOp::Never:
+        case ConditionOp::All:
+        case ConditionOp::Any:
+        case ConditionOp::Not:
+            continue;
+        default:
+            break;
+        }
+        const ConditionDependency dependency{node.dataRef, node.index, node.op == ConditionOp::StringEquals};
+        if (std::find(out.begin(), out.end(), dependency) == out.end()) out.push_back(dependency);
     }
+}
 
-    if (actionConfig.contains("conditions")) {
-        const auto& conditions = actionConfig["conditions"];
-        if (conditions.is_array()) {
-            return std::all_of(conditions.begin(), conditions.end(),
-                                       [this, verbose](const auto& condition)
-                                       {
-                                           return EvaluateCondition(condition, verbose);
-                                       });
-        } else {
-            return EvaluateCondition(conditions, verbose);
+uint64_t ConditionEvaluator::SampleDependency(const ConditionDependency& dependency) const {
+    void* drRef = m_dataRefs.Resolve(dependency.dataRef);
+    if (!drRef) return kMissingValue;
+
+    if (dependency.text) {
+        std::array<char, kMaxStringLength> buffer{};
+        return std::hash<std::string_view>{}(ReadText(m_sdk, drRef, buffer));
+    }
+    return std::bit_cast<uint64_t>(m_dataRefs.ReadValue(dependency.dataRef, dependency.index));
+}
+
+void ConditionEvaluator::GroupArrayReads(const std::vector<ConditionDependency>& dependencies,
+                                         std::vector<ArrayWindow>& out) {
+    out.clear();
+    std::vector<std::pair<DataRefId, int>> elements;
+    for (const auto& dependency : dependencies) {
+        if (dependency.index >= 0 && !dependency.text) elements.emplace_back(dependency.dataRef, dependency.index);
+    }
+    std::sort(elements.begin(), elements.end());
+    elements.erase(std::unique(elements.begin(), elements.end()), elements.end());
+
+    // Sweep each dataref's sorted indices, starting a new window when the
+    // next one would make the current window too wide
+    size_t windowStart = 0;
+    for (size_t i = 1; i <= elements.size(); ++i) {
+        const bool extends = i < elements.size() && elements[i].first == elements[windowStart].first &&
+                             elements[i].second - elements[windowStart].second < kMaxArrayWindow;
+        if (extends) continue;
+        if (i - windowStart > 1) {
+            const int first = elements[windowStart].second;
+            out.push_back(ArrayWindow{elements[windowStart].first, first, elements[i - 1].second - first + 1});
         }
+        windowStart = i;
     }
+}
 
-    if (actionConfig.contains("condition")) {
-        return EvaluateCondition(actionConfig["condition"], verbose);
+void ConditionEvaluator::PrefetchArrays(const std::vector<ArrayWindow>& windows) const {
+    for (const auto& window : windows) {
+        if (m_dataRefs.Resolve(window.dataRef)) m_dataRefs.PrefetchElements(window.dataRef, window.first, window.count);
     }
+}
+
+bool ConditionEvaluator::EvaluateCondition(const nlohmann::json& condition, bool verbose) {
+    return Evaluate(CompileCondition(condition), verbose);
+}
 
-    return true;
+bool ConditionEvaluator::EvaluateConditions(const nlohmann::json& actionConfig, bool verbose) {
+    return Evaluate(CompileConditions(actionConfig), verbose);
 }
@@ -18,35 +18,104 @@
 #include "XPlaneSDK.h"
 #include <nlohmann/json.hpp>
 #include "ParsedCondition.h"
+#include "DataRefRegistry.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
 
+/**
+ * @brief Compiles JSON conditions into ConditionTrees and evaluates them.
+ *
+ * Compilation interns every dataref and decodes every operand once, so
+ * evaluating a tree makes no JSON lookups and no allocations; debug text is
+ * only built when verbose logging is on.  The same trees drive event
+ * actions and LEDs.
+ */
 class ConditionEvaluator {
 public:
-    explicit ConditionEvaluator(IXPlaneSDK& sdk) : m_sdk(sdk) {}
+    /** @brief Uses a private DataRefRegistry. */
+    explicit ConditionEvaluator(IXPlaneSDK& sdk)
+        : m_sdk(sdk), m_ownedDataRefs(std::make_unique<DataRefRegistry>(sdk)), m_dataRefs(*m_ownedDataRefs) {}
+
+    ConditionEvaluator(IXPlaneSDK& sdk, DataRefRegistry& dataRefs) : m_sdk(sdk), m_dataRefs(dataRefs) {}
 
     /**
-     * @brief Evaluates a single condition.
+     * @brief Compiles a single condition object, which may be an "all", "any" or "not" group.
      * @param condition The condition JSON object.
+     * @param resolve Look datarefs up now rather than on first evaluation.
+     */
+    [[nodiscard]] ConditionTree CompileCondition(const nlohmann::json& condition, bool resolve = true);
+
+    /**
+     * @brief Compiles the "condition" or "conditions" of an action.
+     * A "conditions" array must all be true.
+     * @param actionConfig The JSON object that may contain "conditions" or "condition".
+     * @param resolve Look datarefs up now rather than on first evaluation.
+     * @return An empty tree if the action has no conditions.
+     */
+    [[nodiscard]] ConditionTree CompileConditions(const nlohmann::json& actionConfig, bool resolve = true);
+
+    /**
+     * @brief Evaluates a compiled condition.
+     * @param tree The compiled condition; an empty tree is true.
      * @param verbose If true, logs evaluation details to X-Plane debug.
-     * @return true if the condition is met, false otherwise.
      */
-    [[nodiscard]] bool EvaluateCondition(const nlohmann::json& condition, bool verbose = false) const;
+    [[nodiscard]] bool Evaluate(const ConditionTree& tree, bool verbose = false) const;
+
+    /**
+     * @brief Appends the dataref elements `tree` reads to `out`, skipping any already listed.
+     */
+    static void CollectDependencies(const ConditionTree& tree, std::vector<ConditionDependency>& out);
 
     /**
-     * @brief Evaluates a single parsed condition.
-     * @param condition The pre-parsed condition struct.
+     * @brief Reads a dependency packed into 64 bits for change detection.
+     * @return The bits of the value, a hash of a string, or kMissingValue if
+     *         the dataref does not exist.
+     */
+    [[nodiscard]] uint64_t SampleDependency(const ConditionDependency& dependency) const;
+
+    static constexpr uint64_t kMissingValue = ~uint64_t{0};
+
+    /**
+     * @brief Groups the numeric array elements in `dependencies` by dataref
+     * into windows that can each be read with one ranged SDK call.
+     * Elements of one dataref more than kMaxArrayWindow apart go in separate
+     * windows; a window covering a single element is left out.
+     */
+    static void GroupArrayReads(const std::vector<ConditionDependency>& dependencies, std::vector<ArrayWindow>& out);
+
+    /**
+     * @brief Reads each window into the registry's frame snapshot.
+     * Only has an effect between DataRefRegistry::BeginFrame() and EndFrame().
+     */
+    void PrefetchArrays(const std::vector<ArrayWindow>& windows) const;
+
+    static constexpr int kMaxArrayWindow = 64;
+
+    /**
+     * @brief Compiles and evaluates a single condition.
+     * @param condition The condition JSON object.
      * @param verbose If true, logs evaluation details to X-Plane debug.
      * @return true if the condition is met, false otherwise.
      */
-    [[nodiscard]] bool EvaluateParsedCondition(const ParsedCondition& condition, bool verbose = false) const;
+    [[nodiscard]] bool EvaluateCondition(const nlohmann::json& condition, bool verbose = false);
 
     /**
-     * @brief Evaluates a list of conditions. All must be true.
+     * @brief Compiles and evaluates the conditions of an action. All must be true.
      * @param actionConfig The JSON object that may contain "conditions" or "condition".
      * @param verbose If true, logs evaluation details to X-Plane debug.
      * @return true if all conditions are met, false otherwise.
      */
-    [[nodiscard]] bool EvaluateConditions(const nlohmann::json& actionConfig, bool verbose = false) const;
+    [[nodiscard]] bool EvaluateConditions(const nlohmann::json& actionConfig, bool verbose = false);
 
 private:
+    void CompileNode(const nlohmann::json& condition, ConditionTree& tree, bool resolve);
+    void CompileGroup(ConditionOp op, const nlohmann::json& children, ConditionTree& tree, bool resolve);
+    void CompileDataRefTests(const nlohmann::json& condition, ConditionTree& tree, bool resolve);
+    bool EvaluateNode(const ConditionTree& tree, uint32_t nodeIndex, bool verbose) const;
+    bool EvaluateLeaf(const ConditionNode& node, bool verbose) const;
+
     IXPlaneSDK& m_sdk;
+    std::unique_ptr<DataRefRegistry> m_ownedDataRefs;
+    DataRefRegistry& m_dataRefs;
 };
@@ -0,0 +1,188 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#include "ConditionTable.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+bool IsNumericTest(ConditionOp op) {
+    switch (op) {
+    case ConditionOp::Range:
+    case ConditionOp::Bit:
+    case ConditionOp::Equal:
+    case ConditionOp::NotEqual:
+    case ConditionOp::Less:
+    case ConditionOp::Greater:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Integer bits of a value for bit tests; values with no integer part in range test as 0
+uint32_t IntegerBits(double value) {
+    if (!(std::abs(value) < 9.0e18)) return 0;
+    return static_cast<uint32_t>(static_cast<int64_t>(value));
+}
+
+} // namespace
+
+void ConditionTable::Clear() {
+    m_dependencies.clear();
+    m_outputCount = 0;
+    m_ruleOutput.clear();
+    m_ruleFirstRow.clear();
+    m_ruleRowCount.clear();
+    m_ruleTree.clear();
+    m_trees.clear();
+    m_rowDependency.clear();
+    m_rowMin.clear();
+    m_rowMax.clear();
+    m_rowBitMask.clear();
+    m_rowNegate.clear();
+}
+
+uint32_t ConditionTable::AddRule(uint32_t output, ConditionTree tree) {
+    ConditionEvaluator::CollectDependencies(tree, m_dependencies);
+    m_outputCount = std::max<size_t>(m_outputCount, output + 1u);
+
+    const auto rule = static_cast<uint32_t>(m_ruleOutput.size());
+    m_ruleOutput.push_back(output);
+    m_ruleFirstRow.push_back(static_cast<uint32_t>(m_rowDependency.size()));
+    if (Flatten(tree)) {
+        m_ruleTree.push_back(-1);
+    } else {
+        m_ruleTree.push_back(static_cast<int32_t>(m_trees.size()));
+        m_trees.push_back(std::move(tree));
+    }
+    m_ruleRowCount.push_back(static_cast<uint32_t>(m_rowDependency.size()) - m_ruleFirstRow.back());
+    return rule;
+}
+
+size_t ConditionTable::GetFlatRuleCount() const {
+    return static_cast<size_t>(std::count(m_ruleTree.begin(), m_ruleTree.end(), -1));
+}
+
+bool ConditionTable::Flatten(const ConditionTree& tree) {
+    if (tree.empty()) return true; // No conditions: always true
+
+    // A single test, or an "all" of tests with no nested groups
+    const auto& root = tree.nodes[0];
+    uint32_t first = 0;
+    if (root.op == ConditionOp::All) {
+        first = 1;
+    } else if (tree.nodes.size() != 1) {
+        return false;
+    }
+    for (uint32_t i = first; i < tree.nodes.size(); ++i) {
+        if (!IsNumericTest(tree.nodes[i].op)) return false;
+    }
+    for (uint32_t i = first; i < tree.nodes.size(); ++i) {
+        AddRow(tree.nodes[i]);
+    }
+    return true;
+}
+
+void ConditionTable::AddRow(const ConditionNode& node) {
+    double minVal = -kInfinity;
+    double maxVal = kInfinity;
+    uint32_t bitMask = 0;
+    uint8_t negate = 0;
+    switch (node.op) {
+    case ConditionOp::Range: minVal = node.operand; maxVal = node.maxVal; break;
+    case ConditionOp::Bit: bitMask = 1u << node.bit; break;
+    case ConditionOp::Equal: minVal = maxVal = node.operand; break;
+    case ConditionOp::NotEqual: minVal = maxVal = node.operand; negate = 1; break;
+    case ConditionOp::Less: maxVal = std::nextafter(node.operand, -kInfinity); break;
+    case ConditionOp::Greater: minVal = std::nextafter(node.operand, kInfinity); break;
+    default: break;
+    }
+
+    m_rowDependency.push_back(DependencyOf(node));
+    m_rowMin.push_back(minVal);
+    m_rowMax.push_back(maxVal);
+    m_rowBitMask.push_back(bitMask);
+    m_rowNegate.push_back(negate);
+}
+
+uint32_t ConditionTable::DependencyOf(const ConditionNode& node) const {
+    const ConditionDependency dependency{node.dataRef, node.index, false};
+    const auto found = std::find(m_dependencies.begin(), m_dependencies.end(), dependency);
+    return static_cast<uint32_t>(found - m_dependencies.begin());
+}
+
+void ConditionTable::Evaluate(const std::vector<uint64_t>& sample, const ConditionEvaluator& evaluator,
+                              std::vector<int32_t>& firstMatch) {
+    const size_t rows = m_rowDependency.size();
+    m_value.resize(rows);
+    m_bits.resize(rows);
+    m_present.resize(rows);
+    m_inRange.resize(rows);
+    m_bitsSet.resize(rows);
+
+    // Gather each row's value from the packed sample
+    for (size_t i = 0; i < rows; ++i) {
+        const uint64_t raw = sample[m_rowDependency[i]];
+        const bool present = raw != ConditionEvaluator::kMissingValue;
+        const double value = present ? std::bit_cast<double>(raw) : 0.0;
+        m_present[i] = present;
+        m_value[i] = value;
+        m_bits[i] = IntegerBits(value);
+    }
+
+    // Range and bit tests for every row.  Each loop is branch-free and works
+    // on columns of a single width so the compiler can vectorise it.
+    const double* value = m_value.data();
+    const double* minVal = m_rowMin.data();
+    const double* maxVal = m_rowMax.data();
+    double* inRange = m_inRange.data();
+    for (size_t i = 0; i < rows; ++i) {
+        const double aboveMin = value[i] >= minVal[i] ? 1.0 : 0.0;
+        const double belowMax = value[i] <= maxVal[i] ? 1.0 : 0.0;
+        inRange[i] = aboveMin * belowMax;
+    }
+    const uint32_t* bits = m_bits.data();
+    const uint32_t* bitMask = m_rowBitMask.data();
+    uint32_t* bitsSet = m_bitsSet.data();
+    for (size_t i = 0; i < rows; ++i) {
+        bitsSet[i] = (bits[i] & bitMask[i]) == bitMask[i];
+    }
+
+    // First passing rule per output; later rules of a matched output are skipped
+    firstMatch.assign(m_outputCount, kNoMatch);
+    for (size_t rule = 0; rule < m_ruleOutput.size(); ++rule) {
+        int32_t& match = firstMatch[m_ruleOutput[rule]];
+        if (match != kNoMatch) continue;
+
+        bool passed = true;
+        if (m_ruleTree[rule] >= 0) {
+            passed = evaluator.Evaluate(m_trees[m_ruleTree[rule]]);
+        } else {
+            const uint32_t end = m_ruleFirstRow[rule] + m_ruleRowCount[rule];
+            for (uint32_t row = m_ruleFirstRow[rule]; row < end && passed; ++row) {
+                passed = m_present[row] && (m_inRange[row] != 0.0) != (m_rowNegate[row] != 0) && m_bitsSet[row];
+            }
+        }
+        if (passed) match = static_cast<int32_t>(rule);
+    }
+}
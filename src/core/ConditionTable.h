@@ -0,0 +1,98 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+#include "ConditionEvaluator.h"
+#include "ParsedCondition.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Compiled rules for a set of outputs, stored as structure-of-arrays.
+ *
+ * Each rule belongs to one output and rules for an output are tried in the
+ * order they were added; the first one that passes wins.  A rule made of
+ * plain numeric tests (range, bit and comparisons, alone or combined for one
+ * dataref) is flattened into rows of the form
+ * `min <= value <= max` (optionally negated) with `value` having all bits of
+ * `bitMask` set, so every row is checked by branch-free passes over
+ * contiguous columns.  Anything else (groups, string tests) keeps its
+ * ConditionTree and is evaluated only when its output is still unmatched.
+ *
+ * Values are not read here: Evaluate() takes one packed sample per
+ * dependency, as produced by ConditionEvaluator::SampleDependency(), so the
+ * caller's change detection and the rules share a single read per frame.
+ */
+class ConditionTable {
+public:
+    static constexpr int32_t kNoMatch = -1;
+
+    void Clear();
+
+    /**
+     * @brief Adds a rule for `output`.
+     * @return The rule's index, for the caller's per-rule payload.
+     */
+    uint32_t AddRule(uint32_t output, ConditionTree tree);
+
+    /** @brief Every dataref element read by the rules, in sample order. */
+    [[nodiscard]] const std::vector<ConditionDependency>& GetDependencies() const { return m_dependencies; }
+
+    [[nodiscard]] size_t GetOutputCount() const { return m_outputCount; }
+    [[nodiscard]] size_t GetRuleCount() const { return m_ruleOutput.size(); }
+    /** @brief Number of rules flattened into rows rather than kept as trees. */
+    [[nodiscard]] size_t GetFlatRuleCount() const;
+
+    /**
+     * @brief Runs the rules against `sample` and stores, for each output, the
+     * index of its first passing rule or kNoMatch in `firstMatch`.
+     * @param sample One value per GetDependencies() entry.
+     * @param evaluator Evaluates rules kept as trees.
+     */
+    void Evaluate(const std::vector<uint64_t>& sample, const ConditionEvaluator& evaluator,
+                  std::vector<int32_t>& firstMatch);
+
+private:
+    bool Flatten(const ConditionTree& tree);
+    void AddRow(const ConditionNode& node);
+    [[nodiscard]] uint32_t DependencyOf(const ConditionNode& node) const;
+
+    std::vector<ConditionDependency> m_dependencies;
+    size_t m_outputCount = 0;
+
+    // Per rule.  Flat rules own rows [m_ruleFirstRow, m_ruleFirstRow + m_ruleRowCount);
+    // the others have m_ruleTree >= 0.
+    std::vector<uint32_t> m_ruleOutput;
+    std::vector<uint32_t> m_ruleFirstRow;
+    std::vector<uint32_t> m_ruleRowCount;
+    std::vector<int32_t> m_ruleTree;
+    std::vector<ConditionTree> m_trees;
+
+    // Per row
+    std::vector<uint32_t> m_rowDependency;
+    std::vector<double> m_rowMin;
+    std::vector<double> m_rowMax;
+    std::vector<uint32_t> m_rowBitMask;
+    std::vector<uint8_t> m_rowNegate;
+
+    // Scratch columns filled by Evaluate()
+    std::vector<double> m_value;
+    std::vector<uint32_t> m_bits;
+    std::vector<uint8_t> m_present;
+    std::vector<double> m_inRange;      // 1.0 if min <= value <= max
+    std::vector<uint32_t> m_bitsSet;    // 1 if the value has every bit of the mask
+};
@@ -93,3 +93,18 @@ nlohmann::json ConfigManager::GetConfigForAircraft(const std::string& aircraftFi
     IFR1_LOG_INFO(sdk, "  - No match found and no fallback available.");
     return {};
 }
+
+nlohmann::json ConfigManager::ResolveDeviceConfig(const nlohmann::json& config, const std::string& serial) {
+    if (!config.is_object() || !config.contains("devices")) {
+        return config;
+    }
+
+    nlohmann::json resolved = config;
+    resolved.erase("devices");
+
+    const auto& devices = config["devices"];
+    if (!serial.empty() && devices.is_object() && devices.contains(serial)) {
+        resolved.merge_patch(devices[serial]);
+    }
+    return resolved;
+}
@@ -40,6 +40,19 @@ public:
      */
     [[nodiscard]] nlohmann::json GetConfigForAircraft(const std::string& aircraftFilename, IXPlaneSDK& sdk) const;
 
+    /**
+     * @brief Produces the configuration for one specific IFR-1 unit.
+     *
+     * A config may contain a top-level "devices" object keyed by serial number.
+     * The entry matching @p serial is applied as a JSON merge patch (RFC 7386)
+     * on top of the rest of the config, so a unit only needs to list the parts
+     * that differ.  The "devices" section itself is removed from the result.
+     * @param config The aircraft configuration.
+     * @param serial The unit's serial number (may be empty).
+     * @return The configuration to use for that unit.
+     */
+    [[nodiscard]] static nlohmann::json ResolveDeviceConfig(const nlohmann::json& config, const std::string& serial);
+
 private:
     std::vector<nlohmann::json> m_configs;
     nlohmann::json m_fallbackConfig;
@@ -0,0 +1,207 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "DataRefRegistry.h"
+#include "Logger.h"
+#include <algorithm>
+
+DataRefId DataRefRegistry::Intern(std::string_view name)
+{
+    std::string key(name);
+    auto it = m_ids.find(key);
+    if (it != m_ids.end()) return it->second;
+
+    const auto id = static_cast<DataRefId>(m_entries.size());
+    m_entries.push_back(Entry{key});
+    m_ids.emplace(std::move(key), id);
+    return id;
+}
+
+void* DataRefRegistry::Resolve(DataRefId id, bool ignoreBackoff)
+{
+    Entry& entry = m_entries[id];
+    if (!entry.handle && (ignoreBackoff || m_sdk.GetElapsedTime() >= entry.nextRetryTime)) {
+        Lookup(entry);
+    }
+    return entry.handle;
+}
+
+void DataRefRegistry::RetryMissing()
+{
+    for (auto& entry : m_entries) {
+        if (!entry.handle) {
+            entry.nextRetryTime = 0.0f;
+            entry.retryDelay = kMinRetryDelay;
+        }
+    }
+}
+
+double DataRefRegistry::ReadValue(DataRefId id, int index)
+{
+    Entry& entry = m_entries[id];
+    if (!m_inFrame) return Fetch(entry, index);
+    // Read-your-own-writes: the SDK has not seen the held value yet
+    if (!m_pendingWrites.empty()) {
+        if (const PendingWrite* pending = FindPendingWrite(id, index)) return pending->value;
+    }
+
+    if (index < 0) {
+        if (entry.valueGeneration != m_generation) {
+            entry.value = Fetch(entry, -1);
+            entry.valueGeneration = m_generation;
+        }
+        return entry.value;
+    }
+
+    const auto slot = static_cast<size_t>(index);
+    if (slot >= entry.elements.size()) {
+        entry.elements.resize(slot + 1);
+        entry.elementGenerations.resize(slot + 1, 0);
+    }
+    if (entry.elementGenerations[slot] != m_generation) {
+        entry.elements[slot] = Fetch(entry, index);
+        entry.elementGenerations[slot] = m_generation;
+    }
+    return entry.elements[slot];
+}
+
+void DataRefRegistry::PrefetchElements(DataRefId id, int first, int count)
+{
+    Entry& entry = m_entries[id];
+    if (!m_inFrame || !entry.handle || first < 0 || count <= 0) return;
+
+    const auto begin = static_cast<size_t>(first);
+    const size_t end = begin + static_cast<size_t>(count);
+    if (end > entry.elements.size()) {
+        entry.elements.resize(end);
+        entry.elementGenerations.resize(end, 0);
+    }
+    if (std::all_of(entry.elementGenerations.begin() + begin, entry.elementGenerations.begin() + end,
+                    [this](uint32_t generation) { return generation == m_generation; })) {
+        return;
+    }
+
+    int read = 0;
+    if (entry.types & static_cast<int>(DataRefType::IntArray)) {
+        m_intBuffer.resize(static_cast<size_t>(count));
+        read = std::clamp(m_sdk.GetDataiArrayRange(entry.handle, m_intBuffer.data(), first, count), 0, count);
+        for (int i = 0; i < read; ++i) entry.elements[begin + i] = static_cast<double>(m_intBuffer[i]);
+    } else {
+        m_floatBuffer.resize(static_cast<size_t>(count));
+        read = std::clamp(m_sdk.GetDatafArrayRange(entry.handle, m_floatBuffer.data(), first, count), 0, count);
+        for (int i = 0; i < read; ++i) entry.elements[begin + i] = static_cast<double>(m_floatBuffer[i]);
+    }
+    std::fill_n(entry.elementGenerations.begin() + begin, read, m_generation);
+}
+
+void DataRefRegistry::BeginFrame()
+{
+    m_inFrame = true;
+    InvalidateValues();
+}
+
+void DataRefRegistry::EndFrame()
+{
+    FlushWrites();
+    m_inFrame = false;
+}
+
+void DataRefRegistry::WriteValue(DataRefId id, int index, double value)
+{
+    const Entry& entry = m_entries[id];
+    const auto intType = index != -1 ? DataRefType::IntArray : DataRefType::Int;
+    value = (entry.types & static_cast<int>(intType)) ? static_cast<double>(static_cast<int>(value))
+                                                      : static_cast<double>(static_cast<float>(value));
+    if (!m_inFrame) {
+        Store(entry, index, value);
+        InvalidateValues();
+        return;
+    }
+
+    if (PendingWrite* pending = FindPendingWrite(id, index)) {
+        pending->value = value;
+    } else {
+        m_pendingWrites.push_back(PendingWrite{id, index, value});
+    }
+}
+
+void DataRefRegistry::FlushWrites()
+{
+    if (m_pendingWrites.empty()) return;
+    for (const auto& write : m_pendingWrites) {
+        IFR1_LOG_VERBOSE(m_sdk, "Writing dataref: {} = {}", m_entries[write.id].name, write.value);
+        Store(m_entries[write.id], write.index, write.value);
+    }
+    m_pendingWrites.clear();
+    // A write may move other datarefs too
+    InvalidateValues();
+}
+
+DataRefRegistry::PendingWrite* DataRefRegistry::FindPendingWrite(DataRefId id, int index)
+{
+    auto it = std::find_if(m_pendingWrites.begin(), m_pendingWrites.end(),
+                           [&](const PendingWrite& w) { return w.id == id && w.index == index; });
+    return it != m_pendingWrites.end() ? &*it : nullptr;
+}
+
+void DataRefRegistry::InvalidateValues()
+{
+    // Generation 0 marks a slot that was never read
+    if (++m_generation == 0) m_generation = 1;
+}
+
+double DataRefRegistry::Fetch(const Entry& entry, int index) const
+{
+    if (index != -1) {
+        if (entry.types & static_cast<int>(DataRefType::IntArray)) {
+            return static_cast<double>(m_sdk.GetDataiArray(entry.handle, index));
+        }
+        return static_cast<double>(m_sdk.GetDatafArray(entry.handle, index));
+    }
+    if (entry.types & static_cast<int>(DataRefType::Int)) {
+        return static_cast<double>(m_sdk.GetDatai(entry.handle));
+    }
+    return static_cast<double>(m_sdk.GetDataf(entry.handle));
+}
+
+void DataRefRegistry::Store(const Entry& entry, int index, double value)
+{
+    if (index != -1) {
+        if (entry.types & static_cast<int>(DataRefType::IntArray)) {
+            m_sdk.SetDataiArray(entry.handle, static_cast<int>(value), index);
+        } else {
+            m_sdk.SetDatafArray(entry.handle, static_cast<float>(value), index);
+        }
+    } else if (entry.types & static_cast<int>(DataRefType::Int)) {
+        m_sdk.SetDatai(entry.handle, static_cast<int>(value));
+    } else {
+        m_sdk.SetDataf(entry.handle, static_cast<float>(value));
+    }
+}
+
+void DataRefRegistry::Lookup(Entry& entry)
+{
+    entry.handle = m_sdk.FindDataRef(entry.name.c_str());
+    if (entry.handle) {
+        entry.types = m_sdk.GetDataRefTypes(entry.handle);
+        return;
+    }
+
+    entry.types = 0;
+    entry.nextRetryTime = m_sdk.GetElapsedTime() + entry.retryDelay;
+    IFR1_LOG_VERBOSE(m_sdk, "DataRef not found: {} (retrying in {}s)", entry.name, entry.retryDelay);
+    entry.retryDelay = std::min(entry.retryDelay * 2.0f, kMaxRetryDelay);
+}
@@ -0,0 +1,170 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+#include "XPlaneSDK.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using DataRefId = uint32_t;
+
+/**
+ * @brief Interned dataref names with cached handles, type flags and values.
+ *
+ * One registry is shared by every EventProcessor, OutputProcessor and
+ * ConditionEvaluator, so each dataref is looked up once no matter how many
+ * actions, conditions and LEDs use it.  Names that do not resolve (datarefs
+ * published late by an aircraft plugin) are retried with exponential
+ * backoff, or immediately after RetryMissing().
+ *
+ * Between BeginFrame() and EndFrame() the registry also keeps a snapshot of
+ * the values read through ReadValue(), so a dataref tested by several LEDs
+ * and conditions costs one SDK call per flight loop tick.  Writes made
+ * through WriteValue() are held until FlushWrites() or EndFrame(), so several
+ * writes to one dataref in a tick cost a single SDK call; reads in between
+ * return the value waiting to be written.
+ *
+ * Must only be used from the flight loop thread.
+ */
+class DataRefRegistry {
+public:
+    explicit DataRefRegistry(IXPlaneSDK& sdk) : m_sdk(sdk) {}
+
+    /**
+     * @brief Returns the ID for a dataref name.
+     * The dataref is looked up by the first Resolve() of the ID.
+     * @param name Bare dataref name, without an array index.
+     */
+    DataRefId Intern(std::string_view name);
+
+    /**
+     * @brief Returns the dataref handle, or nullptr if it does not exist.
+     * A missing dataref is looked up again once its retry delay has passed.
+     * Handles that have been found are returned without calling the SDK.
+     * @param ignoreBackoff Look a missing dataref up now regardless of the delay.
+     */
+    void* Resolve(DataRefId id, bool ignoreBackoff = false);
+
+    /** @brief Type flags (DataRefType) cached when the handle was found; 0 if missing. */
+    [[nodiscard]] int GetTypes(DataRefId id) const { return m_entries[id].types; }
+
+    [[nodiscard]] const std::string& GetName(DataRefId id) const { return m_entries[id].name; }
+
+    /**
+     * @brief Clears the retry delay of every missing dataref.
+     * Call when new datarefs may have appeared, e.g. after an aircraft loads.
+     */
+    void RetryMissing();
+
+    [[nodiscard]] size_t Size() const { return m_entries.size(); }
+
+    /**
+     * @brief Reads a dataref, or one element of an array dataref, as a double.
+     * Uses the cached type flags to pick the int or float accessor.  Inside a
+     * frame each value is fetched from the SDK at most once.
+     * @param id A dataref whose Resolve() returned a handle.
+     * @param index Array element, or -1 for a scalar dataref.
+     */
+    double ReadValue(DataRefId id, int index = -1);
+
+    /**
+     * @brief Fills the frame snapshot with elements [first, first + count) of
+     * an array dataref using one SDK call, so later ReadValue() calls for
+     * them are served from the snapshot.  Does nothing outside a frame or if
+     * every element is already current; elements the SDK does not return are
+     * fetched one at a time as usual.
+     * @param id A dataref whose Resolve() returned a handle.
+     */
+    void PrefetchElements(DataRefId id, int first, int count);
+
+    /** @brief Starts a new value snapshot for this flight loop tick. */
+    void BeginFrame();
+
+    /** @brief True between BeginFrame() and EndFrame(). */
+    [[nodiscard]] bool InFrame() const { return m_inFrame; }
+
+    /**
+     * @brief Sends held writes and stops caching values; reads and writes go
+     * straight to the SDK until the next BeginFrame().
+     */
+    void EndFrame();
+
+    /**
+     * @brief Writes a dataref, or one element of an array dataref.
+     * Uses the cached type flags to pick the int or float accessor; int
+     * datarefs receive the value truncated.  Inside a frame the write is held
+     * and replaces any earlier one to the same element.
+     * @param id A dataref whose Resolve() returned a handle.
+     * @param index Array element, or -1 for a scalar dataref.
+     */
+    void WriteValue(DataRefId id, int index, double value);
+
+    /** @brief Sends the held writes, one SDK call per dataref element. */
+    void FlushWrites();
+
+    /** @brief Number of writes held for the next FlushWrites(). */
+    [[nodiscard]] size_t GetPendingWriteCount() const { return m_pendingWrites.size(); }
+
+    /**
+     * @brief Forgets every cached value.
+     * Call after the plugin writes a dataref or runs a command, since either
+     * may change values already in the snapshot.
+     */
+    void InvalidateValues();
+
+private:
+    struct Entry {
+        std::string name;
+        void* handle = nullptr;
+        int types = 0;
+        float nextRetryTime = 0.0f;
+        float retryDelay = kMinRetryDelay;
+
+        // Value snapshot; a slot is current when its generation matches m_generation
+        uint32_t valueGeneration = 0;
+        double value = 0.0;
+        std::vector<uint32_t> elementGenerations;
+        std::vector<double> elements;
+    };
+
+    struct PendingWrite {
+        DataRefId id;
+        int index;
+        double value;               // Already narrowed to the dataref's type
+    };
+
+    static constexpr float kMinRetryDelay = 1.0f;
+    static constexpr float kMaxRetryDelay = 30.0f;
+
+    void Lookup(Entry& entry);
+    double Fetch(const Entry& entry, int index) const;
+    void Store(const Entry& entry, int index, double value);
+    PendingWrite* FindPendingWrite(DataRefId id, int index);
+
+    IXPlaneSDK& m_sdk;
+    std::vector<Entry> m_entries;
+    std::unordered_map<std::string, DataRefId> m_ids;
+    uint32_t m_generation = 1;
+    bool m_inFrame = false;
+    // Few datarefs are written per tick, so a linear search beats hashing
+    std::vector<PendingWrite> m_pendingWrites;
+    // Reused by PrefetchElements()
+    std::vector<int> m_intBuffer;
+    std::vector<float> m_floatBuffer;
+};
@@ -16,17 +16,18 @@
 
 #include "DeviceHandler.h"
 #include "Logger.h"
+#include <algorithm>
 #include <cctype>
-
-DeviceHandler::DeviceHandler(IHardwareManager& hw, EventProcessor& eventProc, OutputProcessor& outputProc, SettingsManager& settings, IXPlaneSDK& sdk, bool startThread) 
-    : m_hw(hw), m_eventProc(eventProc), m_outputProc(outputProc), m_settings(settings), m_sdk(sdk), m_modeDisplay(sdk, settings) {
-    for (auto& state : m_buttonStates) {
-        state.currentlyHeld = false;
-        state.pressStartTime = 0.0f;
-        state.longPressDetected = false;
+#include <bit>
+#include <cstdlib>
+
+DeviceHandler::DeviceHandler(IHardwareManager& hw, EventProcessor& eventProc, OutputProcessor& outputProc, SettingsManager& settings, IXPlaneSDK& sdk, bool startThread,
+                             const DeviceProfile& profile)
+    : m_hw(hw), m_eventProc(eventProc), m_outputProc(outputProc), m_settings(settings), m_sdk(sdk), m_profile(profile), m_modeDisplay(sdk, settings) {
+    const std::string clickSoundPath = m_sdk.GetSystemPath() + "Resources/sounds/systems/click.wav";
+    if (m_sdk.FileExists(clickSoundPath)) {
+        m_clickSound = m_sdk.LoadSound(clickSoundPath);
     }
-    m_clickSoundPath = m_sdk.GetSystemPath() + "Resources/sounds/systems/click.wav";
-    m_clickSoundExists = m_sdk.FileExists(m_clickSoundPath);
 
     m_running = true;
     if (startThread) {
@@ -35,7 +36,14 @@ DeviceHandler::DeviceHandler(IHardwareManager& hw, EventProcessor& eventProc, Ou
 }
 
 DeviceHandler::~DeviceHandler() {
-    m_running = false;
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_running = false;
+    }
+    m_wakeCv.notify_all();
+    m_workerSignal.fetch_add(1);
+    m_workerSignal.notify_one();
+    m_hw.Shutdown();
     if (m_thread.joinable()) {
         m_thread.join();
     }
@@ -52,11 +60,17 @@ void DeviceHandler::Update(const nlohmann::json& config, float currentTime) {
         ClearLEDs();
     } else if (!currentlyConnected && m_lastConnectedState) {
         IFR1_LOG_ERROR(m_sdk, "Device disconnected.");
+        // Its buttons will never report a release
+        m_eventProc.ReleaseAllControls();
+        m_downButtons = 0;
     }
     m_lastConnectedState = currentlyConnected;
 
     if (!currentlyConnected) {
-        m_lastModeString.clear();
+        // Drop anything left over from the previous connection; the worker
+        // only produces into the queue while connected
+        m_inputQueue.Clear();
+        m_lastModeId = -1;
         return;
     }
 
@@ -64,43 +78,26 @@ void DeviceHandler::Update(const nlohmann::json& config, float currentTime) {
     while (auto event = m_inputQueue.Pop()) {
         ProcessReport(*event, config, currentTime);
     }
-
-    // Process long presses even if no new HID report (timer based)
-    // Only check buttons that are actually currently held
-    for (int i : m_heldButtons) {
-        if (!m_buttonStates[i].longPressDetected) {
-            if (currentTime - m_buttonStates[i].pressStartTime >= 0.3f) {
-                m_buttonStates[i].longPressDetected = true;
-
-                auto btn = static_cast<IFR1::Button>(i);
-                IFR1_LOG_VERBOSE(m_sdk, "Button {} long-press", GetControlString(btn, m_currentMode));
-                if (btn == IFR1::Button::INNER_KNOB) {
-                    if (m_clickSoundExists) {
-                        m_sdk.PlaySound(m_clickSoundPath);
-                    }
-                    m_shifted = !m_shifted;
-                } else {
-                    m_eventProc.ProcessEvent(config, GetModeString(m_currentMode, m_shifted), GetControlString(btn, m_currentMode), "long-press");
-                }
-            }
-        }
+    FlushKnobs(config, currentTime);
+    // The worker stopped reading when the queue backed up; it can go on now
+    if (m_inputBackpressured) {
+        m_workerSignal.fetch_add(1);
+        m_workerSignal.notify_one();
     }
 
-    std::string currentModeStr = GetModeString(m_currentMode, m_shifted);
-    if (currentModeStr != m_lastModeString) {
+    const uint8_t modeId = EventId::ModeOf(m_currentMode, m_shifted);
+    if (modeId != m_lastModeId) {
         std::string osdPosition = m_settings.GetString("osd-position", "disabled");
-        if (!currentModeStr.empty() && osdPosition != "disabled") {
-            std::string displayStr = currentModeStr;
-            
-            auto it = m_modeDescriptions.find(currentModeStr);
-            if (it != m_modeDescriptions.end()) {
-                displayStr = it->second;
+        if (osdPosition != "disabled") {
+            std::string displayStr = m_modeDescriptions[modeId];
+            if (displayStr.empty()) {
+                displayStr = EventId::ModeName(modeId);
             }
-            
+
             for (auto& c : displayStr) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
             m_modeDisplay.ShowMessage(displayStr, currentTime);
         }
-        m_lastModeString = currentModeStr;
+        m_lastModeId = modeId;
     }
 
     m_modeDisplay.Update(currentTime);
@@ -108,228 +105,330 @@ void DeviceHandler::Update(const nlohmann::json& config, float currentTime) {
 }
 
 void DeviceHandler::ParseModeDescriptions(const nlohmann::json& config) {
-    m_modeDescriptions.clear();
+    m_modeDescriptions.fill({});
     if (config.contains("modes")) {
         for (auto it = config["modes"].begin(); it != config["modes"].end(); ++it) {
-            if (it.value().contains("description") && it.value()["description"].is_string()) {
-                m_modeDescriptions[it.key()] = it.value()["description"].get<std::string>();
+            auto modeId = EventId::Find(EventId::MODE_NAMES, it.key());
+            if (modeId && it.value().contains("description") && it.value()["description"].is_string()) {
+                m_modeDescriptions[*modeId] = it.value()["description"].get<std::string>();
             }
         }
     }
 }
 
-void DeviceHandler::UpdateLEDs(float currentTime) {
+void DeviceHandler::UpdateLEDs() {
     if (!m_isConnected) return;
 
-    uint8_t ledBits = m_outputProc.EvaluateLEDs(currentTime);
+    LedProgram program = m_outputProc.EvaluateProgram();
     
     // Add mode flash bit if shifted
     if (m_shifted) {
-        ledBits |= IFR1::LEDMask::MODE_FLASH;
+        program.solid |= IFR1::LEDMask::MODE_FLASH;
     }
 
-    if (ledBits != m_lastLedBits) {
-        IFR1_LOG_VERBOSE(m_sdk, "LEDs being updated.  Bits: {}", ledBits);
-        m_outputQueue.Push(ledBits);
-        m_lastLedBits = ledBits;
+    if (program != m_lastProgram) {
+        IFR1_LOG_VERBOSE(m_sdk, "LED program being updated.  Solid: {}  Blinking: {}", program.solid, program.blinking);
+        m_lastProgram = program;
+        m_ledMailbox.Publish(program);
+        WakeWorker();
     }
 }
 
 void DeviceHandler::ClearLEDs() {
     m_shifted = false;
     m_currentMode = IFR1::Mode::COM1;
-    m_lastLedBits = 0;
-    m_outputQueue.Push(0);
-    m_heldButtons.clear();
-    for (auto& state : m_buttonStates) {
-        state.currentlyHeld = false;
-        state.longPressDetected = false;
+    m_lastProgram = LedProgram{};
+    m_ledMailbox.Publish(LedProgram{});
+    WakeWorker();
+    for (auto& knob : m_knobs) {
+        knob.pendingTicks = 0;
     }
+    m_eventProc.ReleaseAllControls();
+}
+
+void DeviceHandler::WakeWorker() {
+    // A backpressured worker waits on the signal rather than in the backend
+    m_workerSignal.fetch_add(1);
+    m_workerSignal.notify_one();
+    m_hw.Wake();
 }
 
 void DeviceHandler::ProcessReport(const IFR1::HardwareEvent& event, const nlohmann::json& config, float currentTime) {
     if (event.mode != m_currentMode) {
+        // Detents turned before the mode change belong to the old mode
+        FlushKnobs(config, currentTime);
+        m_eventProc.CancelSequences();
+        // Held buttons map to other controls in the new mode
+        m_eventProc.ReleaseAllControls();
         m_shifted = false;
         m_currentMode = event.mode;
     }
 
-    HandleKnobs(event, config);
+    HandleKnobs(event, config, currentTime);
     HandleButtons(event, config, currentTime);
 }
 
 IFR1::HardwareEvent DeviceHandler::ParseReport(const uint8_t* data) {
-    // data[1..3] buttons, data[5] outer knob, data[6] inner knob, data[7] mode
+    // Field locations come from the device profile's compiled extraction program
+    const DecodedReport decoded = m_profile.Decode(data);
 
     IFR1::HardwareEvent event;
-    event.outerKnobRotation = static_cast<int8_t>(data[5]);
-    event.innerKnobRotation = static_cast<int8_t>(data[6]);
+    event.outerKnobRotation = decoded.outerKnob;
+    event.innerKnobRotation = decoded.innerKnob;
+    event.buttons = decoded.buttons;
 
     // Validate the mode byte before casting; fall back to COM1 on unknown values
-    const auto rawMode = data[7];
-    if (rawMode <= static_cast<uint8_t>(IFR1::Mode::XPDR)) {
-        event.mode = static_cast<IFR1::Mode>(rawMode);
+    if (decoded.mode <= static_cast<uint8_t>(IFR1::Mode::XPDR)) {
+        event.mode = static_cast<IFR1::Mode>(decoded.mode);
     } else {
-        IFR1_LOG_ERROR(m_sdk, "HID report contained unknown mode byte 0x{:02X}; defaulting to COM1", rawMode);
+        IFR1_LOG_ERROR(m_sdk, "HID report contained unknown mode byte 0x{:02X}; defaulting to COM1", decoded.mode);
         event.mode = IFR1::Mode::COM1;
     }
 
-    auto checkBit = [](uint8_t val, uint8_t bit) {
-        if (bit == 0) return false;
-        return (val & (1u << (bit - 1))) != 0;
-    };
-
-    event.buttonStates[static_cast<int>(IFR1::Button::DIRECT)] = checkBit(data[1], IFR1::BitPosition::DIRECT);
-    event.buttonStates[static_cast<int>(IFR1::Button::MENU)] = checkBit(data[1], IFR1::BitPosition::MENU);
-    event.buttonStates[static_cast<int>(IFR1::Button::CLR)] = checkBit(data[1], IFR1::BitPosition::CLR);
-    event.buttonStates[static_cast<int>(IFR1::Button::ENT)] = checkBit(data[1], IFR1::BitPosition::ENT);
-
-    event.buttonStates[static_cast<int>(IFR1::Button::SWAP)] = checkBit(data[2], IFR1::BitPosition::SWAP);
-    event.buttonStates[static_cast<int>(IFR1::Button::INNER_KNOB)] = checkBit(data[2], IFR1::BitPosition::INNER_KNOB);
-    event.buttonStates[static_cast<int>(IFR1::Button::AP)] = checkBit(data[2], IFR1::BitPosition::AP);
-    event.buttonStates[static_cast<int>(IFR1::Button::HDG)] = checkBit(data[2], IFR1::BitPosition::HDG);
-
-    event.buttonStates[static_cast<int>(IFR1::Button::NAV)] = checkBit(data[3], IFR1::BitPosition::NAV);
-    event.buttonStates[static_cast<int>(IFR1::Button::APR)] = checkBit(data[3], IFR1::BitPosition::APR);
-    event.buttonStates[static_cast<int>(IFR1::Button::ALT)] = checkBit(data[3], IFR1::BitPosition::ALT);
-    event.buttonStates[static_cast<int>(IFR1::Button::VS)] = checkBit(data[3], IFR1::BitPosition::VS);
-
     return event;
 }
 
-void DeviceHandler::HandleKnobs(const IFR1::HardwareEvent& event, const nlohmann::json& config) const
+void DeviceHandler::HandleKnobs(const IFR1::HardwareEvent& event, const nlohmann::json& config, float currentTime)
 {
-    if (event.outerKnobRotation != 0) {
-        std::string action = (event.outerKnobRotation > 0) ? "rotate-clockwise" : "rotate-counterclockwise";
-        IFR1_LOG_VERBOSE(m_sdk, "Outer knob {}", action);
-        for (int i = 0; i < std::abs(event.outerKnobRotation); ++i) {
-            m_eventProc.ProcessEvent(config, GetModeString(m_currentMode, m_shifted), "outer-knob", action);
+    const int8_t rotations[2] = { event.outerKnobRotation, event.innerKnobRotation };
+    for (size_t i = 0; i < m_knobs.size(); ++i) {
+        if (rotations[i] == 0) continue;
+        // A change of direction ends the current run
+        if ((m_knobs[i].pendingTicks > 0) != (rotations[i] > 0) && m_knobs[i].pendingTicks != 0) {
+            FlushKnobs(config, currentTime);
         }
+        m_knobs[i].pendingTicks += rotations[i];
     }
-    if (event.innerKnobRotation != 0) {
-        std::string action = (event.innerKnobRotation > 0) ? "rotate-clockwise" : "rotate-counterclockwise";
-        IFR1_LOG_VERBOSE(m_sdk, "Inner knob {}", action);
-        for (int i = 0; i < std::abs(event.innerKnobRotation); ++i) {
-            m_eventProc.ProcessEvent(config, GetModeString(m_currentMode, m_shifted), "inner-knob", action);
+}
+
+void DeviceHandler::FlushKnobs(const nlohmann::json& config, float currentTime)
+{
+    for (auto& knob : m_knobs) {
+        if (knob.pendingTicks == 0) continue;
+
+        const int count = std::abs(knob.pendingTicks);
+        const auto action = (knob.pendingTicks > 0) ? EventId::Action::ROTATE_CLOCKWISE : EventId::Action::ROTATE_COUNTERCLOCKWISE;
+        knob.pendingTicks = 0;
+
+        // Detents per second since the previous dispatch.  The first turn after
+        // the knob has been idle reads as slow, so acceleration never kicks in
+        // on a single click.
+        float velocity = 0.0f;
+        if (knob.lastDispatchTime >= 0.0f) {
+            velocity = static_cast<float>(count) / std::max(currentTime - knob.lastDispatchTime, kMinKnobInterval);
         }
+        knob.lastDispatchTime = currentTime;
+
+        IFR1_LOG_VERBOSE(m_sdk, "{} {} x{} ({} detents/s)", EventId::ControlName(knob.control), EventId::ActionName(action), count, velocity);
+        m_eventProc.ProcessEvent(config, EventId::ModeOf(m_currentMode, m_shifted), knob.control, action, count, velocity);
     }
 }
 
 void DeviceHandler::HandleButtons(const IFR1::HardwareEvent& event, const nlohmann::json& config, float currentTime) {
-    for (int i = 0; i < 12; ++i) {
-        bool current = event.buttonStates[i];
-        bool last = m_buttonStates[i].currentlyHeld;
-
-        if (current && !last) {
-            // Pressed
-            IFR1_LOG_VERBOSE(m_sdk, "Button {} pressed", GetControlString(static_cast<IFR1::Button>(i), m_currentMode));
-            m_buttonStates[i].currentlyHeld = true;
-            m_buttonStates[i].pressStartTime = currentTime;
-            m_buttonStates[i].longPressDetected = false;
-            m_heldButtons.push_back(i);
-        } else if (!current && last) {
-            // Released
-            IFR1_LOG_VERBOSE(m_sdk, "Button {} released", GetControlString(static_cast<IFR1::Button>(i), m_currentMode));
-            if (!m_buttonStates[i].longPressDetected) {
-                // Short press
-                m_eventProc.ProcessEvent(config, GetModeString(m_currentMode, m_shifted), GetControlString(static_cast<IFR1::Button>(i), m_currentMode), "short-press");
+    const uint16_t pressed = event.buttons & ~m_downButtons;
+    const uint16_t released = m_downButtons & ~event.buttons;
+    m_downButtons = event.buttons;
+    if (pressed == 0 && released == 0 && event.shortPresses == 0 && event.longPresses == 0) return;
+
+    // Keep knob turns and button presses in the order they happened
+    FlushKnobs(config, currentTime);
+
+    for (uint16_t down = pressed; down != 0; down &= down - 1) {
+        auto btn = static_cast<IFR1::Button>(std::countr_zero(down));
+        const auto control = EventId::ControlOf(btn, m_currentMode);
+        m_eventProc.ProcessEvent(config, EventId::ModeOf(m_currentMode, m_shifted), control, EventId::Action::PRESS);
+    }
+
+    for (uint16_t presses = event.shortPresses; presses != 0; presses &= presses - 1) {
+        auto btn = static_cast<IFR1::Button>(std::countr_zero(presses));
+        const auto control = EventId::ControlOf(btn, m_currentMode);
+        IFR1_LOG_VERBOSE(m_sdk, "Button {} short-press", EventId::ControlName(control));
+        m_eventProc.ProcessEvent(config, EventId::ModeOf(m_currentMode, m_shifted), control, EventId::Action::SHORT_PRESS);
+    }
+    for (uint16_t presses = event.longPresses; presses != 0; presses &= presses - 1) {
+        auto btn = static_cast<IFR1::Button>(std::countr_zero(presses));
+        const auto control = EventId::ControlOf(btn, m_currentMode);
+        IFR1_LOG_VERBOSE(m_sdk, "Button {} long-press", EventId::ControlName(control));
+        if (btn == IFR1::Button::INNER_KNOB) {
+            if (m_clickSound != kNoSound) {
+                m_sdk.PlaySound(m_clickSound);
             }
-            m_buttonStates[i].currentlyHeld = false;
-            m_buttonStates[i].longPressDetected = false;
-            std::erase(m_heldButtons, i);
+            // The shifted mode is a separate mode, so end what the old one
+            // started just as the mode selector does
+            m_eventProc.CancelSequences();
+            m_eventProc.ReleaseAllControls();
+            m_shifted = !m_shifted;
+        } else {
+            m_eventProc.ProcessEvent(config, EventId::ModeOf(m_currentMode, m_shifted), control, EventId::Action::LONG_PRESS);
         }
     }
+    // Ends holds and repeats after the release's short-press has run
+    for (uint16_t up = released; up != 0; up &= up - 1) {
+        auto btn = static_cast<IFR1::Button>(std::countr_zero(up));
+        m_eventProc.ReleaseControl(EventId::ControlOf(btn, m_currentMode));
+    }
 }
 
-std::string DeviceHandler::GetModeString(IFR1::Mode mode, bool shifted) {
-    if (!shifted) {
-        switch (mode) {
-            case IFR1::Mode::COM1: return "com1";
-            case IFR1::Mode::COM2: return "com2";
-            case IFR1::Mode::NAV1: return "nav1";
-            case IFR1::Mode::NAV2: return "nav2";
-            case IFR1::Mode::FMS1: return "fms1";
-            case IFR1::Mode::FMS2: return "fms2";
-            case IFR1::Mode::AP: return "ap";
-            case IFR1::Mode::XPDR: return "xpdr";
-        }
-    } else {
-        switch (mode) {
-            case IFR1::Mode::COM1: return "hdg";
-            case IFR1::Mode::COM2: return "baro";
-            case IFR1::Mode::NAV1: return "crs1";
-            case IFR1::Mode::NAV2: return "crs2";
-            case IFR1::Mode::FMS1: return "fms1-alt";
-            case IFR1::Mode::FMS2: return "fms2-alt";
-            case IFR1::Mode::AP: return "ap-alt";
-            case IFR1::Mode::XPDR: return "xpdr-mode";
-        }
+void DeviceHandler::ClassifyButtons(IFR1::HardwareEvent& event) {
+    // A held button may cross the long-press threshold before its release
+    // report arrives, so check timing against this report first
+    event.longPresses |= DetectLongPresses(event.timestamp);
+
+    const uint16_t changed = event.buttons ^ m_heldButtons;
+    if (changed == 0) return;
+
+    for (uint16_t pressed = changed & event.buttons; pressed != 0; pressed &= pressed - 1) {
+        m_pressStartTimes[std::countr_zero(pressed)] = event.timestamp;
     }
-    return "";
+
+    // Releases that were not already reported as long presses are short presses
+    const uint16_t released = changed & m_heldButtons;
+    event.shortPresses |= released & ~m_longPressedButtons;
+    m_longPressedButtons &= ~released;
+    m_heldButtons = event.buttons;
 }
 
-std::string DeviceHandler::GetControlString(IFR1::Button button, IFR1::Mode mode) {
-    if (mode == IFR1::Mode::FMS1 || mode == IFR1::Mode::FMS2) {
-        switch (button) {
-            case IFR1::Button::AP: return "cdi";
-            case IFR1::Button::HDG: return "obs";
-            case IFR1::Button::NAV: return "msg";
-            case IFR1::Button::APR: return "fpl";
-            case IFR1::Button::ALT: return "vnav";
-            case IFR1::Button::VS: return "proc";
-            default: break;
+uint16_t DeviceHandler::DetectLongPresses(std::chrono::steady_clock::time_point now) {
+    uint16_t longPresses = 0;
+    for (uint16_t pending = m_heldButtons & ~m_longPressedButtons; pending != 0; pending &= pending - 1) {
+        const int i = std::countr_zero(pending);
+        if (now - m_pressStartTimes[i] >= kLongPressThreshold) {
+            longPresses |= static_cast<uint16_t>(1u << i);
         }
     }
+    m_longPressedButtons |= longPresses;
+    return longPresses;
+}
+
+int DeviceHandler::GetLongPressWaitMs(std::chrono::steady_clock::time_point now) const {
+    int waitMs = -1;
+    for (uint16_t pending = m_heldButtons & ~m_longPressedButtons; pending != 0; pending &= pending - 1) {
+        auto deadline = m_pressStartTimes[std::countr_zero(pending)] + kLongPressThreshold;
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - now);
+        int ms = static_cast<int>(std::max<int64_t>(remaining.count(), 0));
+        waitMs = (waitMs < 0) ? ms : std::min(waitMs, ms);
+    }
+    return waitMs;
+}
+
+int DeviceHandler::GetBlinkWaitMs(std::chrono::steady_clock::time_point now) const {
+    if (!m_ledProgram || m_ledProgram->blinking == 0) return -1;
+    const double seconds = std::chrono::duration<double>(now.time_since_epoch()).count();
+    const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+        std::chrono::duration<double>(m_ledProgram->NextEdge(seconds) - seconds));
+    return static_cast<int>(std::max<int64_t>(remaining.count(), 0));
+}
 
-    switch (button) {
-        case IFR1::Button::DIRECT: return "direct-to";
-        case IFR1::Button::MENU: return "menu";
-        case IFR1::Button::CLR: return "clr";
-        case IFR1::Button::ENT: return "ent";
-        case IFR1::Button::SWAP: return "swap";
-        case IFR1::Button::AP: return "ap";
-        case IFR1::Button::HDG: return "hdg";
-        case IFR1::Button::NAV: return "nav";
-        case IFR1::Button::APR: return "apr";
-        case IFR1::Button::ALT: return "alt";
-        case IFR1::Button::VS: return "vs";
-        case IFR1::Button::INNER_KNOB: return "inner-knob-button";
-        default: return "";
+bool DeviceHandler::WriteLEDs(std::chrono::steady_clock::time_point now) {
+    // Only the newest program matters; states published and replaced since
+    // the last pass are never written
+    if (auto program = m_ledMailbox.Take()) {
+        m_ledProgram = *program;
     }
+    if (!m_ledProgram || !m_profile.HasLEDs()) return true;
+
+    // Blinks are rendered against the monotonic clock, not the sim's
+    const double seconds = std::chrono::duration<double>(now.time_since_epoch()).count();
+    const uint8_t ledBits = m_ledProgram->Render(seconds);
+    // The device already shows these bits
+    if (ledBits == m_writtenLedBits) return true;
+
+    uint8_t report[2] = { m_profile.GetLEDReportId(), ledBits };
+    if (m_hw.Write(report, 2) < 0) return false;
+    m_writtenLedBits = ledBits;
+    return true;
 }
 
 void DeviceHandler::ProcessHardware() {
-    uint8_t readBuffer[IFR1::HID_REPORT_SIZE + 1]{};
+    uint8_t readBuffer[DeviceProfile::kMaxReportSize + 1]{};
+    const size_t reportSize = m_profile.GetReportSize();
+    const size_t minReportLength = m_profile.GetMinReportLength();
 
     bool currentlyConnected = m_hw.IsConnected();
     if (!currentlyConnected) {
         m_isConnected = false;
         // Don't try to connect if we are shutting down
-        if (!m_running || !m_hw.Connect(IFR1::VENDOR_ID, IFR1::PRODUCT_ID)) {
+        if (!m_running || !m_hw.Connect(m_profile.GetVendorId(), m_profile.GetProductId())) {
             return;
         }
+        // Drop the LED state of the previous connection before announcing this
+        // one, so the flight loop's reset on reconnect is never discarded; stale
+        // input reports are discarded by the flight loop (the queue's consumer)
+        // while disconnected
+        m_ledMailbox.Discard();
+        m_ledProgram.reset();
+        m_writtenLedBits = -1;
         m_isConnected = true;
-        // Clear queues on fresh connection to avoid stale reports/updates
-        m_inputQueue.Clear();
-        m_outputQueue.Clear();
         m_lastReport.fill(0);
+        // Presses in flight when the device went away can never complete
+        m_heldButtons = 0;
+        m_longPressedButtons = 0;
     } else {
         m_isConnected = true;
     }
 
-    // 1. Read from device
-    int bytesRead = m_hw.Read(readBuffer, IFR1::HID_REPORT_SIZE, 10); // 10ms timeout
-    int reportsRead = 0;
-    while (bytesRead > 0) {
-        // Require at least 8 bytes so all fields accessed by ParseReport are valid
-        if (bytesRead >= 8) {
-            m_inputQueue.Push(ParseReport(readBuffer));
+    // 1. Write pending LED state first so it never waits behind a read timeout
+    if (!WriteLEDs(m_clock())) {
+        m_hw.Disconnect();
+        m_isConnected = false;
+        return;
+    }
+
+    // 2. Drain the device until it has nothing left or the flight loop falls
+    // behind.  Backends that can wait for input have already blocked in
+    // WaitForInput(), so only polling backends need a read timeout here.
+    m_inputBackpressured = false;
+    uint32_t reportsRead = 0;
+    int bytesRead = 0;
+    while (true) {
+        if (m_inputQueue.Size() >= kInputHighWater) {
+            m_inputBackpressured = true;
+            m_statBackpressureStalls.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        bytesRead = m_hw.Read(readBuffer, reportSize, (reportsRead == 0 && !m_hw.CanWaitForInput()) ? 10 : 0);
+        if (bytesRead <= 0) break;
+        ++reportsRead;
+
+        // Require every byte the profile reads so all fields accessed by ParseReport are valid
+        if (static_cast<size_t>(bytesRead) >= minReportLength) {
+            // Knob fields are relative, so a repeated report that moves a knob is
+            // new input; anything else identical to the last report changes nothing
+            bool isNew = !std::equal(readBuffer, readBuffer + minReportLength, m_lastReport.begin());
+            if (!isNew) {
+                const DecodedReport decoded = m_profile.Decode(readBuffer);
+                isNew = decoded.outerKnob != 0 || decoded.innerKnob != 0;
+            }
+            if (isNew) {
+                std::copy(readBuffer, readBuffer + minReportLength, m_lastReport.begin());
+                IFR1::HardwareEvent event = ParseReport(readBuffer);
+                // Stamped per report: a press and its release drained in
+                // the same pass must not measure as zero length
+                event.timestamp = m_clock();
+                ClassifyButtons(event);
+                m_workerMode = event.mode;
+                m_inputQueue.Push(event);
+            }
         } else {
-            IFR1_LOG_ERROR(m_sdk, "Partial HID read ({} bytes); expected at least 8 — report discarded", bytesRead);
+            IFR1_LOG_ERROR(m_sdk, "Partial HID read ({} bytes); expected at least {} — report discarded", bytesRead, minReportLength);
         }
-        if (++reportsRead >= 10) break;
         // Clear the buffer before the next read to avoid stale bytes from a previous partial read
         std::fill(std::begin(readBuffer), std::end(readBuffer), uint8_t{0});
-        bytesRead = m_hw.Read(readBuffer, IFR1::HID_REPORT_SIZE, 0); // No timeout for subsequent reads
+    }
+
+    if (reportsRead > 0) {
+        m_statWakeups.fetch_add(1, std::memory_order_relaxed);
+        m_statReportsRead.fetch_add(reportsRead, std::memory_order_relaxed);
+        m_statLastBurst.store(reportsRead, std::memory_order_relaxed);
+        if (reportsRead > m_statMaxBurst.load(std::memory_order_relaxed)) {
+            m_statMaxBurst.store(reportsRead, std::memory_order_relaxed);
+        }
+    }
+
+    const uint64_t dropped = m_inputQueue.DroppedCount();
+    if (dropped != m_reportedDrops) {
+        IFR1_LOG_ERROR(m_sdk, "Input queue full; {} hardware event(s) dropped so far", dropped);
+        m_reportedDrops = dropped;
     }
 
     if (bytesRead < 0) {
@@ -338,27 +437,74 @@ void DeviceHandler::ProcessHardware() {
         return;
     }
 
-    // 2. Write to device
-    while (auto ledBits = m_outputQueue.Pop()) {
-        uint8_t report[2] = { IFR1::HID_LED_REPORT_ID, *ledBits };
-        if (m_hw.Write(report, 2) < 0) {
-            m_hw.Disconnect();
-            m_isConnected = false;
-            break;
-        }
+    // 3. Buttons held past the threshold without a new report
+    const auto now = m_clock();
+    if (uint16_t longPresses = DetectLongPresses(now)) {
+        IFR1::HardwareEvent event;
+        event.mode = m_workerMode;
+        event.buttons = m_heldButtons;
+        event.longPresses = longPresses;
+        event.timestamp = now;
+        m_inputQueue.Push(event);
     }
 }
 
+DeviceHandler::InputStats DeviceHandler::GetInputStats() const {
+    InputStats stats;
+    stats.wakeups = m_statWakeups.load(std::memory_order_relaxed);
+    stats.reportsRead = m_statReportsRead.load(std::memory_order_relaxed);
+    stats.lastReportsPerWakeup = m_statLastBurst.load(std::memory_order_relaxed);
+    stats.maxReportsPerWakeup = m_statMaxBurst.load(std::memory_order_relaxed);
+    stats.backpressureStalls = m_statBackpressureStalls.load(std::memory_order_relaxed);
+    stats.droppedEvents = m_inputQueue.DroppedCount();
+    return stats;
+}
+
+void DeviceHandler::WaitForReconnect() {
+    if (m_hw.SupportsHotplug()) {
+        // Sleep until udev reports the device; the timeout is only a safety net
+        // in case a hotplug event is missed
+        m_hw.WaitForDevice(kHotplugSafetyTimeoutMs);
+        return;
+    }
+
+    // No hotplug notifications: poll Connect() with exponential backoff
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    m_wakeCv.wait_for(lock, std::chrono::milliseconds(m_reconnectDelayMs), [this] { return !m_running; });
+    m_reconnectDelayMs = std::min(m_reconnectDelayMs * 2, kMaxReconnectDelayMs);
+}
+
 void DeviceHandler::WorkerThread() {
-    while (m_running || (m_isConnected && !m_outputQueue.IsEmpty())) {
+    while (m_running || (m_isConnected && m_ledMailbox.HasNew())) {
         bool wasConnected = m_isConnected;
         ProcessHardware();
+        if (m_isConnected) {
+            m_reconnectDelayMs = kMinReconnectDelayMs;
+        }
         
-        // Small sleep to prevent tight loop if Read is non-blocking or returns immediately
-        // or if we're waiting for reconnection
+        // Polling backends already block in the first Read() of each pass, so
+        // only a lost connection needs an explicit sleep here
         if (!m_isConnected && !wasConnected && m_running) {
-             std::this_thread::sleep_for(std::chrono::milliseconds(500));
-        } else {
+             WaitForReconnect();
+        } else if (m_isConnected && m_running && m_inputBackpressured) {
+             // The device still has reports queued; sleep until the flight
+             // loop drains the input queue.  That may take indefinitely (no
+             // aircraft loaded), so there is no timeout to poll on.  The
+             // queue is checked after loading the signal, so a drain that
+             // raced ahead of this wait is not missed.
+             const uint32_t signal = m_workerSignal.load();
+             if (m_running && m_inputQueue.Size() >= kInputHighWater) {
+                 m_workerSignal.wait(signal);
+             }
+        } else if (m_isConnected && m_running && m_hw.CanWaitForInput()) {
+             // Sleep in the kernel until a report arrives; LED updates and
+             // shutdown interrupt the wait through Wake().  A held button or
+             // a blinking LED bounds the wait so its deadline is met on time.
+             const auto now = m_clock();
+             const int longPressMs = GetLongPressWaitMs(now);
+             const int blinkMs = GetBlinkWaitMs(now);
+             m_hw.WaitForInput((longPressMs < 0 || blinkMs < 0) ? std::max(longPressMs, blinkMs) : std::min(longPressMs, blinkMs));
+        } else if (!m_isConnected) {
              std::this_thread::sleep_for(std::chrono::milliseconds(20));
         }
     }
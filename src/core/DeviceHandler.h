@@ -17,20 +17,45 @@
 #pragma once
 #include "IHardwareManager.h"
 #include "IFR1Protocol.h"
+#include "DeviceProfile.h"
+#include "EventIds.h"
 #include "EventProcessor.h"
 #include "OutputProcessor.h"
 #include "XPlaneSDK.h"
-#include "ThreadSafeQueue.h"
+#include "SPSCRingBuffer.h"
+#include "LatestValueMailbox.h"
 #include "ModeDisplay.h"
 #include "SettingsManager.h"
+#include "LedProgram.h"
 #include <array>
+#include <chrono>
 #include <thread>
 #include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
 #include <vector>
 
 class DeviceHandler {
 public:
-    DeviceHandler(IHardwareManager& hw, EventProcessor& eventProc, OutputProcessor& outputProc, SettingsManager& settings, IXPlaneSDK& sdk, bool startThread = true);
+    /**
+     * @brief Worker-side read counters, safe to read from any thread.
+     */
+    struct InputStats {
+        uint64_t wakeups = 0;              // ProcessHardware passes that read at least one report
+        uint64_t reportsRead = 0;          // Total reports drained from the device
+        uint32_t lastReportsPerWakeup = 0; // Reports drained by the most recent such pass
+        uint32_t maxReportsPerWakeup = 0;  // Largest burst drained in one pass
+        uint64_t backpressureStalls = 0;   // Passes cut short because the input queue was nearly full
+        uint64_t droppedEvents = 0;        // Events lost because the input queue was full
+    };
+
+    /**
+     * @param profile Report layout of the device; defaults to the IFR-1.
+     */
+    DeviceHandler(IHardwareManager& hw, EventProcessor& eventProc, OutputProcessor& outputProc, SettingsManager& settings, IXPlaneSDK& sdk, bool startThread = true,
+                  const DeviceProfile& profile = DeviceProfile::IFR1());
     ~DeviceHandler();
 
     /**
@@ -47,30 +72,54 @@ public:
     void ParseModeDescriptions(const nlohmann::json& config);
 
     /**
-     * @brief Updates the LEDs on the device.
-     * @param currentTime Current time in seconds.
+     * @brief Publishes the LED program to the worker when it has changed.
+     * Blinking is timed by the worker, so this only needs to run once per frame.
      */
-    void UpdateLEDs(float currentTime);
+    void UpdateLEDs();
 
     /**
-     * @brief Turns off all LEDs and clears the flash bit.
+     * @brief Turns off all LEDs and clears the flash bit.  Holds and repeats
+     * still running are released.
      */
     void ClearLEDs();
 
     /**
      * @brief Performs one iteration of the hardware communication logic.
-     * Used by the worker thread or manually in tests.
+     * Used by the worker thread or manually in tests.  Each report is
+     * timestamped from the clock as soon as it has been read.
      */
     void ProcessHardware();
 
+    /**
+     * @brief Monotonic time source for report timestamps, press timing and blinking.
+     */
+    using Clock = std::function<std::chrono::steady_clock::time_point()>;
+
+    /**
+     * @brief Replaces steady_clock::now() so tests can control time.  Only
+     * for handlers constructed without a worker thread.
+     */
+    void SetClock(Clock clock) { m_clock = std::move(clock); }
+
+    /**
+     * @brief Snapshot of the worker's read counters.
+     */
+    [[nodiscard]] InputStats GetInputStats() const;
+
 private:
     void ProcessReport(const IFR1::HardwareEvent& event, const nlohmann::json& config, float currentTime);
-    static std::string GetModeString(IFR1::Mode mode, bool shifted);
-    static std::string GetControlString(IFR1::Button button, IFR1::Mode mode);
-    void HandleKnobs(const IFR1::HardwareEvent& event, const nlohmann::json& config) const;
+    void HandleKnobs(const IFR1::HardwareEvent& event, const nlohmann::json& config, float currentTime);
+    void FlushKnobs(const nlohmann::json& config, float currentTime);
     void HandleButtons(const IFR1::HardwareEvent& event, const nlohmann::json& config, float currentTime);
+    void ClassifyButtons(IFR1::HardwareEvent& event);
+    uint16_t DetectLongPresses(std::chrono::steady_clock::time_point now);
+    [[nodiscard]] int GetLongPressWaitMs(std::chrono::steady_clock::time_point now) const;
+    [[nodiscard]] int GetBlinkWaitMs(std::chrono::steady_clock::time_point now) const;
+    bool WriteLEDs(std::chrono::steady_clock::time_point now);
+    void WakeWorker();
     
     void WorkerThread();
+    void WaitForReconnect();
     IFR1::HardwareEvent ParseReport(const uint8_t* data);
 
     IHardwareManager& m_hw;
@@ -78,37 +127,86 @@ private:
     OutputProcessor& m_outputProc;
     SettingsManager& m_settings;
     IXPlaneSDK& m_sdk;
+    const DeviceProfile m_profile;
+    Clock m_clock = [] { return std::chrono::steady_clock::now(); };
 
-    std::unordered_map<std::string, std::string> m_modeDescriptions;
+    // Indexed by EventId mode; empty if the config gives no description
+    std::array<std::string, EventId::MODE_COUNT> m_modeDescriptions;
 
     // Threading
     std::thread m_thread;
     std::atomic<bool> m_running{false};
-    ThreadSafeQueue<IFR1::HardwareEvent> m_inputQueue;
-    ThreadSafeQueue<uint8_t> m_outputQueue;
+    // Reconnect pacing while the device is unplugged; see WaitForReconnect()
+    static constexpr int kMinReconnectDelayMs = 250;
+    static constexpr int kMaxReconnectDelayMs = 5000;
+    static constexpr int kHotplugSafetyTimeoutMs = 30000;
+    int m_reconnectDelayMs = kMinReconnectDelayMs;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCv;
+    // Worker thread produces reports, flight loop consumes them
+    SPSCRingBuffer<IFR1::HardwareEvent, 256> m_inputQueue;
+    // The worker stops draining the device once the input queue holds this many
+    // events, leaving further reports in the OS buffer until the flight loop
+    // catches up.  The headroom keeps room for timer-generated long presses.
+    static constexpr size_t kInputHighWater = decltype(m_inputQueue)::GetCapacity() - 32;
+    std::atomic<bool> m_inputBackpressured{false};
+    // Bumped when the flight loop frees queue space, publishes LEDs or shuts
+    // the worker down; a backpressured worker sleeps on it instead of polling
+    std::atomic<uint32_t> m_workerSignal{0};
+    std::atomic<uint64_t> m_statWakeups{0};
+    std::atomic<uint64_t> m_statReportsRead{0};
+    std::atomic<uint32_t> m_statLastBurst{0};
+    std::atomic<uint32_t> m_statMaxBurst{0};
+    std::atomic<uint64_t> m_statBackpressureStalls{0};
+    uint64_t m_reportedDrops = 0;
+    // Flight loop publishes the desired LED program, worker thread renders
+    // the newest one; programs superseded before the worker runs are never sent
+    LatestValueMailbox<LedProgram> m_ledMailbox;
     std::atomic<bool> m_isConnected{false};
 
     // State
     IFR1::Mode m_currentMode = IFR1::Mode::COM1;
     bool m_shifted = false;
-    uint8_t m_lastLedBits = 0;
+    LedProgram m_lastProgram;
     bool m_lastConnectedState = false;
+    // Buttons down as of the last report the flight loop handled; its edges
+    // drive "press" events and the release of holds and repeats
+    uint16_t m_downButtons = 0;
     
-    // Button state tracking
-    struct ButtonState {
-        bool currentlyHeld = false;
-        float pressStartTime = 0.0f;
-        bool longPressDetected = false;
+    // Button state tracking.  Owned by the worker thread, which classifies
+    // presses against report timestamps so press timing does not depend on
+    // the sim frame rate.
+    // Masks use bit n for IFR1::Button n.
+    static constexpr auto kLongPressThreshold = std::chrono::milliseconds(300);
+    uint16_t m_heldButtons = 0;
+    uint16_t m_longPressedButtons = 0;
+    std::array<std::chrono::steady_clock::time_point, IFR1::BUTTON_COUNT> m_pressStartTimes{};
+    IFR1::Mode m_workerMode = IFR1::Mode::COM1;
+
+    // LED program last taken by the worker and the bits the device last
+    // acknowledged, or -1 if unknown (nothing written since connecting)
+    std::optional<LedProgram> m_ledProgram;
+    int m_writtenLedBits = -1;
+
+    // Knob detents are summed across all reports drained in one frame and
+    // dispatched once with a count and speed; see FlushKnobs()
+    struct KnobState {
+        EventId::Control control;
+        int pendingTicks = 0;
+        float lastDispatchTime = -1.0f;
     };
-    std::array<ButtonState, 12> m_buttonStates;
-    std::vector<int> m_heldButtons;
+    // Shortest interval used for the speed estimate, so a burst that lands in
+    // a single frame does not read as infinitely fast
+    static constexpr float kMinKnobInterval = 0.02f;
+    std::array<KnobState, 2> m_knobs{{{EventId::Control::OUTER_KNOB}, {EventId::Control::INNER_KNOB}}};
     
-    // Last raw report to detect changes
-    std::array<uint8_t, IFR1::HID_REPORT_SIZE> m_lastReport{};
+    // Last raw report; identical reports without knob movement are skipped
+    std::array<uint8_t, DeviceProfile::kMaxReportSize> m_lastReport{};
 
-    std::string m_clickSoundPath;
-    bool m_clickSoundExists = false;
+    // Shift toggle click, loaded in the background at construction
+    SoundId m_clickSound = kNoSound;
 
     ModeDisplay m_modeDisplay;
-    std::string m_lastModeString;
+    // EventId mode last shown on the OSD, or -1 to show the next one
+    int m_lastModeId = -1;
 };
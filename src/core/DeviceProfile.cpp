@@ -0,0 +1,274 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "DeviceProfile.h"
+#include "EventIds.h"
+#include "IFR1Protocol.h"
+#include "Logger.h"
+#include <algorithm>
+#include <bit>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+uint8_t BitMask(uint8_t bitPosition) {
+    return static_cast<uint8_t>(1u << (bitPosition - 1));
+}
+
+nlohmann::json BuildIFR1Profile() {
+    using namespace IFR1;
+    auto button = [](int byteIndex, uint8_t bitPosition) {
+        return nlohmann::json{{"byte", byteIndex}, {"mask", BitMask(bitPosition)}};
+    };
+    return {
+        {"name", "Octavi IFR-1"},
+        {"vendor-id", VENDOR_ID},
+        {"product-id", PRODUCT_ID},
+        {"report-size", HID_REPORT_SIZE},
+        {"led-report-id", HID_LED_REPORT_ID},
+        {"mode", {{"byte", 7}, {"mask", 0xFF}}},
+        {"knobs", {
+            {"outer-knob", {{"byte", 5}}},
+            {"inner-knob", {{"byte", 6}}}
+        }},
+        {"buttons", {
+            {"direct-to", button(1, BitPosition::DIRECT)},
+            {"menu", button(1, BitPosition::MENU)},
+            {"clr", button(1, BitPosition::CLR)},
+            {"ent", button(1, BitPosition::ENT)},
+            {"swap", button(2, BitPosition::SWAP)},
+            {"inner-knob-button", button(2, BitPosition::INNER_KNOB)},
+            {"ap", button(2, BitPosition::AP)},
+            {"hdg", button(2, BitPosition::HDG)},
+            {"nav", button(3, BitPosition::NAV)},
+            {"apr", button(3, BitPosition::APR)},
+            {"alt", button(3, BitPosition::ALT)},
+            {"vs", button(3, BitPosition::VS)}
+        }}
+    };
+}
+
+// Accepts a JSON number or a string in decimal or 0x-prefixed hex
+std::optional<unsigned long> ParseNumber(const nlohmann::json& value) {
+    if (value.is_number_unsigned() || (value.is_number_integer() && value.get<long long>() >= 0)) {
+        return value.get<unsigned long>();
+    }
+    if (value.is_string()) {
+        try {
+            size_t used = 0;
+            const auto& text = value.get_ref<const std::string&>();
+            unsigned long parsed = std::stoul(text, &used, 0);
+            if (used == text.size()) return parsed;
+        } catch (const std::exception&) {
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace
+
+const DeviceProfile& DeviceProfile::IFR1() {
+    static const DeviceProfile profile = [] {
+        std::string error;
+        return *Compile(BuildIFR1Profile(), error);
+    }();
+    return profile;
+}
+
+std::optional<DeviceProfile> DeviceProfile::Compile(const nlohmann::json& profile, std::string& error) {
+    if (!profile.is_object()) {
+        error = "profile must be a JSON object";
+        return std::nullopt;
+    }
+
+    DeviceProfile result;
+    result.m_name = profile.value("name", "Unnamed device");
+
+    auto readNumber = [&](const nlohmann::json& parent, const char* key, unsigned long maxValue,
+                          std::optional<unsigned long> fallback = std::nullopt) -> std::optional<unsigned long> {
+        if (!parent.contains(key)) {
+            if (!fallback) error = std::string("missing '") + key + "'";
+            return fallback;
+        }
+        auto value = ParseNumber(parent[key]);
+        if (!value || *value > maxValue) {
+            error = std::string("'") + key + "' must be a number from 0 to " + std::to_string(maxValue);
+            return std::nullopt;
+        }
+        return value;
+    };
+
+    auto vendorId = readNumber(profile, "vendor-id", 0xFFFF);
+    if (!vendorId) return std::nullopt;
+    auto productId = readNumber(profile, "product-id", 0xFFFF);
+    if (!productId) return std::nullopt;
+    auto reportSize = readNumber(profile, "report-size", kMaxReportSize);
+    if (!reportSize) return std::nullopt;
+    if (*reportSize == 0) {
+        error = "'report-size' must be at least 1";
+        return std::nullopt;
+    }
+    result.m_vendorId = static_cast<uint16_t>(*vendorId);
+    result.m_productId = static_cast<uint16_t>(*productId);
+    result.m_reportSize = *reportSize;
+
+    if (profile.contains("led-report-id")) {
+        auto ledReportId = readNumber(profile, "led-report-id", 0xFF);
+        if (!ledReportId) return std::nullopt;
+        result.m_ledReportId = static_cast<uint8_t>(*ledReportId);
+    }
+
+    // Reads {"byte": n, "mask": m} and validates it against the report size
+    auto readField = [&](const nlohmann::json& field, const std::string& name, bool contiguous) -> std::optional<FieldOp> {
+        if (!field.is_object()) {
+            error = "'" + name + "' must be an object";
+            return std::nullopt;
+        }
+        auto byteIndex = readNumber(field, "byte", result.m_reportSize - 1);
+        if (!byteIndex) {
+            error = "'" + name + "': " + error;
+            return std::nullopt;
+        }
+        auto mask = readNumber(field, "mask", 0xFF, 0xFF);
+        if (!mask || *mask == 0) {
+            error = "'" + name + "': 'mask' must be a non-zero number from 1 to 255";
+            return std::nullopt;
+        }
+
+        FieldOp op;
+        op.byteIndex = static_cast<uint8_t>(*byteIndex);
+        op.mask = static_cast<uint8_t>(*mask);
+        op.shift = static_cast<uint8_t>(std::countr_zero(op.mask));
+        op.width = static_cast<uint8_t>(std::popcount(op.mask));
+        if (contiguous && !std::has_single_bit(static_cast<unsigned>((op.mask >> op.shift) + 1))) {
+            error = "'" + name + "': 'mask' bits must be contiguous";
+            return std::nullopt;
+        }
+        result.m_minReportLength = std::max<size_t>(result.m_minReportLength, op.byteIndex + 1u);
+        return op;
+    };
+
+    if (profile.contains("buttons")) {
+        if (!profile["buttons"].is_object()) {
+            error = "'buttons' must be an object";
+            return std::nullopt;
+        }
+        for (const auto& [name, field] : profile["buttons"].items()) {
+            // Profile button names are the config names of the IFR-1 buttons
+            auto buttonIndex = EventId::Find(EventId::CONTROL_NAMES, name);
+            if (!buttonIndex || *buttonIndex >= IFR1::BUTTON_COUNT) {
+                error = "unknown button '" + name + "'";
+                return std::nullopt;
+            }
+            auto op = readField(field, name, false);
+            if (!op) return std::nullopt;
+
+            // Fold this button into the lookup table for its byte
+            auto table = std::find_if(result.m_buttonTables.begin(), result.m_buttonTables.end(),
+                                      [&](const ButtonTable& t) { return t.byteIndex == op->byteIndex; });
+            if (table == result.m_buttonTables.end()) {
+                result.m_buttonTables.push_back(ButtonTable{op->byteIndex, {}});
+                table = std::prev(result.m_buttonTables.end());
+            }
+            const auto bit = static_cast<uint16_t>(1u << *buttonIndex);
+            for (unsigned value = 0; value < 256; ++value) {
+                if (value & op->mask) table->masks[value] |= bit;
+            }
+        }
+    }
+
+    if (profile.contains("knobs")) {
+        const auto& knobs = profile["knobs"];
+        if (!knobs.is_object()) {
+            error = "'knobs' must be an object";
+            return std::nullopt;
+        }
+        for (const auto& [name, field] : knobs.items()) {
+            if (name != "outer-knob" && name != "inner-knob") {
+                error = "unknown knob '" + name + "'";
+                return std::nullopt;
+            }
+            auto op = readField(field, name, true);
+            if (!op) return std::nullopt;
+            (name == "outer-knob" ? result.m_outerKnob : result.m_innerKnob) = op;
+        }
+    }
+
+    if (profile.contains("mode")) {
+        result.m_mode = readField(profile["mode"], "mode", true);
+        if (!result.m_mode) return std::nullopt;
+    }
+
+    if (result.m_minReportLength == 0) {
+        error = "profile defines no buttons, knobs or mode";
+        return std::nullopt;
+    }
+
+    error.clear();
+    return result;
+}
+
+std::vector<DeviceProfile> DeviceProfile::LoadProfiles(const std::string& directoryPath, IXPlaneSDK& sdk) {
+    std::vector<DeviceProfile> profiles;
+    std::error_code ec;
+    if (!fs::is_directory(directoryPath, ec)) return profiles;
+
+    for (const auto& entry : fs::directory_iterator(directoryPath, ec)) {
+        if (entry.path().extension() != ".json") continue;
+        try {
+            std::ifstream file(entry.path());
+            nlohmann::json json;
+            file >> json;
+
+            std::string error;
+            if (auto profile = Compile(json, error)) {
+                IFR1_LOG_INFO(sdk, "Loaded device profile '{}' ({:04X}:{:04X}) from {}", profile->GetName(),
+                              profile->GetVendorId(), profile->GetProductId(), entry.path().filename().string());
+                profiles.push_back(std::move(*profile));
+            } else {
+                IFR1_LOG_ERROR(sdk, "Invalid device profile {}: {}", entry.path().filename().string(), error);
+            }
+        } catch (const std::exception& e) {
+            IFR1_LOG_ERROR(sdk, "Error parsing device profile {}: {}", entry.path().filename().string(), e.what());
+        }
+    }
+    return profiles;
+}
+
+uint8_t DeviceProfile::ExtractUnsigned(const uint8_t* report, const FieldOp& op) {
+    return static_cast<uint8_t>((report[op.byteIndex] & op.mask) >> op.shift);
+}
+
+int8_t DeviceProfile::ExtractSigned(const uint8_t* report, const FieldOp& op) {
+    int value = ExtractUnsigned(report, op);
+    // Two's complement within the field width
+    const int signBit = 1 << (op.width - 1);
+    return static_cast<int8_t>((value ^ signBit) - signBit);
+}
+
+DecodedReport DeviceProfile::Decode(const uint8_t* report) const {
+    DecodedReport decoded;
+    for (const auto& table : m_buttonTables) {
+        decoded.buttons |= table.masks[report[table.byteIndex]];
+    }
+    if (m_outerKnob) decoded.outerKnob = ExtractSigned(report, *m_outerKnob);
+    if (m_innerKnob) decoded.innerKnob = ExtractSigned(report, *m_innerKnob);
+    if (m_mode) decoded.mode = ExtractUnsigned(report, *m_mode);
+    return decoded;
+}
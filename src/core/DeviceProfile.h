@@ -0,0 +1,120 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+#include "XPlaneSDK.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief Input fields extracted from one HID report by a DeviceProfile.
+ */
+struct DecodedReport {
+    uint16_t buttons = 0;      // Bit n is IFR1::Button n
+    int8_t outerKnob = 0;
+    int8_t innerKnob = 0;
+    uint8_t mode = 0;          // Raw mode selector value; 0 if the device has none
+};
+
+/**
+ * @brief Describes the HID report layout of a controller.
+ *
+ * A profile is written in JSON (see documentation/device_profiles.md) and
+ * compiled once at load into a flat program: one 256-entry lookup table per
+ * report byte that carries buttons, plus a byte/mask/shift operation per knob
+ * and for the mode selector.  Decode() then runs that program with no
+ * branching on the layout, so any controller goes through the same pipeline
+ * as the IFR-1.
+ *
+ * Controls map onto the IFR-1 control set (12 buttons, two knobs, eight
+ * modes), so aircraft configs work unchanged with any profiled device.
+ */
+class DeviceProfile {
+public:
+    /**
+     * @brief The built-in Octavi IFR-1 layout.
+     */
+    static const DeviceProfile& IFR1();
+
+    /**
+     * @brief Compiles a profile from its JSON description.
+     * @param profile The JSON profile.
+     * @param error Receives a description of the problem if compilation fails.
+     * @return The compiled profile, or std::nullopt if the description is invalid.
+     */
+    static std::optional<DeviceProfile> Compile(const nlohmann::json& profile, std::string& error);
+
+    /**
+     * @brief Loads and compiles every .json profile in a directory.
+     * Invalid profiles are logged and skipped.
+     * @param directoryPath Path to the directory containing profile files.
+     * @param sdk Reference to X-Plane SDK for logging.
+     */
+    static std::vector<DeviceProfile> LoadProfiles(const std::string& directoryPath, IXPlaneSDK& sdk);
+
+    /**
+     * @brief Extracts the input fields from a report.
+     * @param report At least GetMinReportLength() bytes of report data.
+     */
+    [[nodiscard]] DecodedReport Decode(const uint8_t* report) const;
+
+    [[nodiscard]] const std::string& GetName() const { return m_name; }
+    [[nodiscard]] uint16_t GetVendorId() const { return m_vendorId; }
+    [[nodiscard]] uint16_t GetProductId() const { return m_productId; }
+    /** @brief Number of bytes to request per read. */
+    [[nodiscard]] size_t GetReportSize() const { return m_reportSize; }
+    /** @brief Reports shorter than this do not contain every field and are discarded. */
+    [[nodiscard]] size_t GetMinReportLength() const { return m_minReportLength; }
+    [[nodiscard]] bool HasLEDs() const { return m_ledReportId.has_value(); }
+    [[nodiscard]] uint8_t GetLEDReportId() const { return m_ledReportId.value_or(0); }
+
+    static constexpr size_t kMaxReportSize = 64;
+
+private:
+    // One byte of a report holding buttons, decoded with a single table lookup
+    struct ButtonTable {
+        uint8_t byteIndex = 0;
+        std::array<uint16_t, 256> masks{};
+    };
+
+    // (report[byteIndex] & mask) >> shift, sign-extended from `width` bits for knobs
+    struct FieldOp {
+        uint8_t byteIndex = 0;
+        uint8_t mask = 0;
+        uint8_t shift = 0;
+        uint8_t width = 0;
+    };
+
+    static uint8_t ExtractUnsigned(const uint8_t* report, const FieldOp& op);
+    static int8_t ExtractSigned(const uint8_t* report, const FieldOp& op);
+
+    std::string m_name;
+    uint16_t m_vendorId = 0;
+    uint16_t m_productId = 0;
+    size_t m_reportSize = 0;
+    size_t m_minReportLength = 0;
+    std::optional<uint8_t> m_ledReportId;
+
+    std::vector<ButtonTable> m_buttonTables;
+    std::optional<FieldOp> m_outerKnob;
+    std::optional<FieldOp> m_innerKnob;
+    std::optional<FieldOp> m_mode;
+};
@@ -0,0 +1,73 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "DeviceWatcher.h"
+
+#include <algorithm>
+#include <chrono>
+
+DeviceWatcher::DeviceWatcher(std::vector<std::pair<uint16_t, uint16_t>> ids, Enumerator enumerate, bool startThread)
+    : m_ids(std::move(ids)), m_enumerate(std::move(enumerate)), m_known(m_ids.size()) {
+    Scan();
+
+    m_running = true;
+    if (startThread) {
+        m_thread = std::thread([this] { WatcherThread(); });
+    }
+}
+
+DeviceWatcher::~DeviceWatcher() {
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_running = false;
+    }
+    m_wakeCv.notify_all();
+    m_hotplug.Wake();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+std::optional<DeviceWatcher::NewDevice> DeviceWatcher::TakeNewDevice() {
+    return m_newDevices.Pop();
+}
+
+void DeviceWatcher::Scan() {
+    for (size_t target = 0; target < m_ids.size(); ++target) {
+        auto& known = m_known[target];
+        for (auto& serial : m_enumerate(m_ids[target].first, m_ids[target].second)) {
+            if (std::find(known.begin(), known.end(), serial) != known.end()) continue;
+            // A full queue leaves the serial unknown, so the next scan retries it
+            if (m_newDevices.Push({target, serial})) {
+                known.push_back(std::move(serial));
+            }
+        }
+    }
+}
+
+void DeviceWatcher::WatcherThread() {
+    while (m_running) {
+        if (m_hotplug.IsAvailable()) {
+            m_hotplug.WaitForDevices(m_ids, kHotplugSafetyTimeoutMs);
+        } else {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wakeCv.wait_for(lock, std::chrono::milliseconds(kPollIntervalMs), [this] { return !m_running; });
+        }
+        if (m_running) {
+            Scan();
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+#include "HotplugMonitor.h"
+#include "SPSCRingBuffer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Finds controller units as they are plugged in.
+ *
+ * The constructor enumerates every watched vendor/product ID once, so the
+ * units attached at startup are available straight away.  A background thread
+ * then sleeps on udev hotplug events (or polls when udev is unavailable) and
+ * enumerates again whenever a matching device comes or goes.  Each serial
+ * number is reported once; the flight loop collects them with
+ * TakeNewDevice() and creates a device context for each.
+ */
+class DeviceWatcher {
+public:
+    using Enumerator = std::function<std::vector<std::string>(uint16_t vendorId, uint16_t productId)>;
+
+    struct NewDevice {
+        size_t target = 0;  // Index into the IDs passed to the constructor
+        std::string serial;
+    };
+
+    /**
+     * @param ids Vendor/product ID pairs to watch.
+     * @param enumerate Lists the serial numbers attached for one ID pair.
+     * @param startThread If false, only the initial and manual Scan() calls run.
+     */
+    DeviceWatcher(std::vector<std::pair<uint16_t, uint16_t>> ids, Enumerator enumerate, bool startThread = true);
+    ~DeviceWatcher();
+
+    DeviceWatcher(const DeviceWatcher&) = delete;
+    DeviceWatcher& operator=(const DeviceWatcher&) = delete;
+
+    /**
+     * @brief Returns the next unit not reported before, if any.  Never blocks.
+     */
+    std::optional<NewDevice> TakeNewDevice();
+
+    /**
+     * @brief Enumerates every watched ID pair once and queues unseen serials.
+     * Used by the watcher thread or manually in tests.
+     */
+    void Scan();
+
+private:
+    void WatcherThread();
+
+    // Enumeration is only a safety net when udev is watching
+    static constexpr int kHotplugSafetyTimeoutMs = 30000;
+    static constexpr int kPollIntervalMs = 5000;
+
+    const std::vector<std::pair<uint16_t, uint16_t>> m_ids;
+    const Enumerator m_enumerate;
+    // Serials already reported, per ID pair; owned by whichever thread scans
+    std::vector<std::vector<std::string>> m_known;
+    // Watcher thread produces, flight loop consumes
+    SPSCRingBuffer<NewDevice, 16> m_newDevices;
+
+    HotplugMonitor m_hotplug;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCv;
+};
@@ -0,0 +1,122 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+#include "IFR1Protocol.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+/**
+ * @brief Small integer IDs for the mode, control and action names used in
+ * aircraft configs.
+ *
+ * DeviceHandler and EventProcessor pass these instead of strings, and
+ * EventProcessor indexes its dispatch table with them.  The names below are
+ * the spellings accepted in the JSON config.
+ */
+namespace EventId {
+
+// IFR1::Mode values, followed by the same modes in the shifted state
+constexpr uint8_t MODE_COUNT = 16;
+
+inline constexpr std::array<std::string_view, MODE_COUNT> MODE_NAMES = {
+    "com1", "com2", "nav1", "nav2", "fms1", "fms2", "ap", "xpdr",
+    "hdg", "baro", "crs1", "crs2", "fms1-alt", "fms2-alt", "ap-alt", "xpdr-mode"
+};
+
+// The first IFR1::BUTTON_COUNT controls are the buttons, in IFR1::Button order
+enum class Control : uint8_t {
+    DIRECT_TO = 0,
+    MENU,
+    CLR,
+    ENT,
+    SWAP,
+    AP,
+    HDG,
+    NAV,
+    APR,
+    ALT,
+    VS,
+    INNER_KNOB_BUTTON,
+    // FMS modes rename the bottom row of buttons
+    CDI,
+    OBS,
+    MSG,
+    FPL,
+    VNAV,
+    PROC,
+    OUTER_KNOB,
+    INNER_KNOB,
+    COUNT
+};
+
+inline constexpr std::array<std::string_view, static_cast<size_t>(Control::COUNT)> CONTROL_NAMES = {
+    "direct-to", "menu", "clr", "ent", "swap", "ap", "hdg", "nav", "apr", "alt", "vs", "inner-knob-button",
+    "cdi", "obs", "msg", "fpl", "vnav", "proc",
+    "outer-knob", "inner-knob"
+};
+
+enum class Action : uint8_t {
+    SHORT_PRESS = 0,
+    LONG_PRESS,
+    ROTATE_CLOCKWISE,
+    ROTATE_COUNTERCLOCKWISE,
+    PRESS,          // Button went down; "hold" and "repeat" actions last until it is released
+    COUNT
+};
+
+inline constexpr std::array<std::string_view, static_cast<size_t>(Action::COUNT)> ACTION_NAMES = {
+    "short-press", "long-press", "rotate-clockwise", "rotate-counterclockwise", "press"
+};
+
+constexpr uint8_t ModeOf(IFR1::Mode mode, bool shifted) {
+    return static_cast<uint8_t>(static_cast<uint8_t>(mode) + (shifted ? 8 : 0));
+}
+
+constexpr Control ControlOf(IFR1::Button button, IFR1::Mode mode) {
+    if (mode == IFR1::Mode::FMS1 || mode == IFR1::Mode::FMS2) {
+        switch (button) {
+            case IFR1::Button::AP: return Control::CDI;
+            case IFR1::Button::HDG: return Control::OBS;
+            case IFR1::Button::NAV: return Control::MSG;
+            case IFR1::Button::APR: return Control::FPL;
+            case IFR1::Button::ALT: return Control::VNAV;
+            case IFR1::Button::VS: return Control::PROC;
+            default: break;
+        }
+    }
+    return static_cast<Control>(button);
+}
+
+constexpr std::string_view ModeName(uint8_t mode) { return MODE_NAMES[mode]; }
+constexpr std::string_view ControlName(Control control) { return CONTROL_NAMES[static_cast<size_t>(control)]; }
+constexpr std::string_view ActionName(Action action) { return ACTION_NAMES[static_cast<size_t>(action)]; }
+
+/**
+ * @brief Looks up a config name in one of the name tables above.
+ * @return Its index, or std::nullopt if the name is not known.
+ */
+template <size_t N>
+std::optional<uint8_t> Find(const std::array<std::string_view, N>& names, std::string_view name) {
+    auto it = std::find(names.begin(), names.end(), name);
+    if (it == names.end()) return std::nullopt;
+    return static_cast<uint8_t>(std::distance(names.begin(), it));
+}
+
+} // namespace EventId
@@ -17,196 +17,418 @@
 #include "EventProcessor.h"
 #include "DataRefUtils.h"
 #include "Logger.h"
+#include <algorithm>
 #include <cmath>
+#include <utility>
 #include <nlohmann/json.hpp>
 
+size_t EventProcessor::DispatchIndex(uint8_t mode, EventId::Control control, EventId::Action action)
+{
+    return (static_cast<size_t>(mode) * kControlCount + static_cast<size_t>(control)) * kActionCount +
+           static_cast<size_t>(action);
+}
+
+void EventProcessor::ProcessEvent(const nlohmann::json& config,
+                                  uint8_t mode,
+                                  EventId::Control control,
+                                  EventId::Action action,
+                                  int count,
+                                  float velocity)
+{
+    if (config.empty() || count <= 0 || mode >= EventId::MODE_COUNT ||
+        control >= EventId::Control::COUNT || action >= EventId::Action::COUNT) {
+        return;
+    }
+
+    // Holds and repeats started by this event last until the control is released
+    if (action == EventId::Action::PRESS) m_pressing = control;
+
+    if (!m_prepared) {
+        ProcessUnpreparedEvent(config, EventId::ModeName(mode), EventId::ControlName(control),
+                               EventId::ActionName(action), count, velocity);
+    } else if (PreparedPlan* plan = m_dispatch[DispatchIndex(mode, control, action)]) {
+        // Fast path: run the plan compiled by PrepareConfig
+        IFR1_LOG_VERBOSE(m_sdk, "Event - mode: {}, control: {}, action: {}, count: {}, velocity: {}", EventId::ModeName(mode),
+                         EventId::ControlName(control), EventId::ActionName(action), count, velocity);
+        m_evaluator.PrefetchArrays(plan->arrayWindows);
+        RunPlan(plan->actions, count, velocity, PriorityOf(action));
+    }
+    m_pressing = EventId::Control::COUNT;
+}
+
 void EventProcessor::ProcessEvent(const nlohmann::json& config,
                                   const std::string& mode,
                                   const std::string& control,
-                                  const std::string& action)
-{
-    if (config.empty()) return;
-
-    // Fast path: use pre-computed action map when available
-    const nlohmann::json* eventConfig = nullptr;
-    if (!m_actionMap.empty()) {
-        std::string key = mode;
-        key += '\x1F';
-        key += control;
-        key += '\x1F';
-        key += action;
-        auto it = m_actionMap.find(key);
-        if (it != m_actionMap.end()) {
-            eventConfig = &it->second;
-        }
-    } else {
-        // Fallback: traverse the JSON hierarchy (used when PrepareConfig has not been called)
-        if (config.contains("modes") &&
-            config["modes"].contains(mode) &&
-            config["modes"][mode].contains(control) &&
-            config["modes"][mode][control].contains(action)) {
-            eventConfig = &config["modes"][mode][control][action];
-        }
-    }
+                                  const std::string& action,
+                                  int count,
+                                  float velocity)
+{
+    if (config.empty() || count <= 0) return;
 
-    if (!eventConfig) return;
+    if (!m_prepared) {
+        ProcessUnpreparedEvent(config, mode, control, action, count, velocity);
+        return;
+    }
 
-    IFR1_LOG_VERBOSE(m_sdk, "Event - mode: {}, control: {}, action: {}", mode, control, action);
+    auto modeId = EventId::Find(EventId::MODE_NAMES, mode);
+    auto controlId = EventId::Find(EventId::CONTROL_NAMES, control);
+    auto actionId = EventId::Find(EventId::ACTION_NAMES, action);
+    if (!modeId || !controlId || !actionId) return;
 
-    auto processActions = [&](const nlohmann::json& actions) {
-        for (const auto& actionConfig : actions) {
-            if (m_evaluator.EvaluateConditions(actionConfig, m_sdk.GetLogLevel() >= LogLevel::Verbose)) {
-                ExecuteAction(actionConfig);
-                if (!ShouldEvaluateNext(actionConfig)) {
-                    break;
-                }
-            }
-        }
-    };
+    ProcessEvent(config, *modeId, static_cast<EventId::Control>(*controlId), static_cast<EventId::Action>(*actionId),
+                 count, velocity);
+}
 
-    if (eventConfig->is_object() && eventConfig->contains("actions") && (*eventConfig)["actions"].is_array()) {
-        processActions((*eventConfig)["actions"]);
-    } else {
-        IFR1_LOG_ERROR(m_sdk, "Event {}/{} in mode {} missing required 'actions' array", control, action, mode);
+void EventProcessor::ProcessUnpreparedEvent(const nlohmann::json& config, std::string_view mode,
+                                            std::string_view control, std::string_view action, int count,
+                                            float velocity)
+{
+    // Fallback: traverse the JSON hierarchy (used when PrepareConfig has not been called)
+    const std::string modeKey(mode), controlKey(control), actionKey(action);
+    if (config.contains("modes") &&
+        config["modes"].contains(modeKey) &&
+        config["modes"][modeKey].contains(controlKey) &&
+        config["modes"][modeKey][controlKey].contains(actionKey)) {
+        IFR1_LOG_VERBOSE(m_sdk, "Event - mode: {}, control: {}, action: {}, count: {}, velocity: {}", mode, control, action, count, velocity);
+        ActionPlan plan = CompileEvent(config["modes"][modeKey][controlKey][actionKey], mode, control, action, false);
+        auto actionId = EventId::Find(EventId::ACTION_NAMES, action);
+        RunPlan(plan, count, velocity,
+                actionId ? PriorityOf(static_cast<EventId::Action>(*actionId)) : CommandPriority::Normal);
     }
 }
 
 void EventProcessor::PrepareConfig(const nlohmann::json& config)
 {
-    m_actionMap.clear();
+    m_prepared = false;
+    m_plans.clear();
+    m_dispatch.fill(nullptr);
+    m_commands.Clear();
+    CancelSequences();
+    ReleaseAllControls();
+
+    // "command-scheduler": {"commands-per-frame": 8, "time-slice-ms": 2.0}
+    int commandsPerFrame = CommandScheduler::kDefaultCommandsPerFrame;
+    float timeSliceMs = CommandScheduler::kDefaultTimeSliceMs;
+    if (config.contains("command-scheduler") && config["command-scheduler"].is_object()) {
+        const auto& scheduler = config["command-scheduler"];
+        commandsPerFrame = scheduler.value("commands-per-frame", commandsPerFrame);
+        timeSliceMs = scheduler.value("time-slice-ms", timeSliceMs);
+    }
+    m_commands.SetBudget(commandsPerFrame, timeSliceMs);
+
     if (config.empty() || !config.contains("modes") || !config["modes"].is_object()) return;
 
+    std::vector<size_t> slots;
     for (auto& [modeName, modeJson] : config["modes"].items()) {
         if (!modeJson.is_object()) continue;
+        auto modeId = EventId::Find(EventId::MODE_NAMES, modeName);
+        if (!modeId) {
+            IFR1_LOG_VERBOSE(m_sdk, "Ignoring unknown mode '{}'", modeName);
+            continue;
+        }
         for (auto& [controlName, controlJson] : modeJson.items()) {
             if (!controlJson.is_object()) continue;
+            auto controlId = EventId::Find(EventId::CONTROL_NAMES, controlName);
+            if (!controlId) {
+                IFR1_LOG_VERBOSE(m_sdk, "Ignoring unknown control '{}' in mode {}", controlName, modeName);
+                continue;
+            }
             for (auto& [actionName, actionJson] : controlJson.items()) {
                 if (!actionJson.is_object()) continue;
-                std::string key = modeName;
-                key += '\x1F';
-                key += controlName;
-                key += '\x1F';
-                key += actionName;
-                m_actionMap.emplace(std::move(key), actionJson);
+                auto actionId = EventId::Find(EventId::ACTION_NAMES, actionName);
+                if (!actionId) {
+                    IFR1_LOG_VERBOSE(m_sdk, "Ignoring unknown action '{}' for {} in mode {}", actionName, controlName, modeName);
+                    continue;
+                }
+                slots.push_back(DispatchIndex(*modeId, static_cast<EventId::Control>(*controlId),
+                                              static_cast<EventId::Action>(*actionId)));
+                PreparedPlan& plan = m_plans.emplace_back();
+                plan.actions = CompileEvent(actionJson, modeName, controlName, actionName, true);
+                std::vector<ConditionDependency> dependencies;
+                for (const auto& compiled : plan.actions) CollectDependencies(compiled, dependencies);
+                ConditionEvaluator::GroupArrayReads(dependencies, plan.arrayWindows);
             }
         }
     }
+
+    // m_plans no longer grows, so pointers into it stay valid until the next PrepareConfig
+    for (size_t i = 0; i < slots.size(); ++i) {
+        m_dispatch[slots[i]] = &m_plans[i];
+    }
+    m_prepared = true;
 }
 
-void EventProcessor::ExecuteAction(const nlohmann::json& actionConfig)
+ActionPlan EventProcessor::CompileEvent(const nlohmann::json& eventConfig, std::string_view mode,
+                                        std::string_view control, std::string_view action, bool resolve)
 {
-    std::string type = actionConfig.value("type", "");
-    std::string value = actionConfig.value("value", "");
+    ActionPlan plan;
+    if (!eventConfig.is_object() || !eventConfig.contains("actions") || !eventConfig["actions"].is_array()) {
+        IFR1_LOG_ERROR(m_sdk, "Event {}/{} in mode {} missing required 'actions' array", control, action, mode);
+        return plan;
+    }
 
-    if (type == "command") {
-        if (void* cmdRef = m_sdk.FindCommand(value.c_str())) {
-            int times = actionConfig.value("send-count", 1);
-            if (times < 0) times = -times;
-
-            if (times > 0) {
-                IFR1_LOG_VERBOSE(m_sdk, "Queueing command: {} ({} times)", value, times);
-                for (int i = 0; i < times; ++i) {
-                    if (m_commandQueue.size() < 10) {
-                        m_commandQueue.push(cmdRef);
-                    } else {
-                        IFR1_LOG_VERBOSE(m_sdk, "Command queue full, discarding command");
-                    }
-                }
-            } else {
-                IFR1_LOG_VERBOSE(m_sdk, "Skipping command: {} (send-count is 0)", value);
-            }
-        } else {
-            IFR1_LOG_ERROR(m_sdk, "Command not found: {}", value);
+    for (const auto& actionConfig : eventConfig["actions"]) {
+        try {
+            plan.push_back(CompileAction(actionConfig, resolve));
+        } catch (const std::exception& e) {
+            IFR1_LOG_ERROR(m_sdk, "Invalid action for {}/{} in mode {}: {}", control, action, mode, e.what());
         }
+    }
+    return plan;
+}
+
+CompiledAction EventProcessor::CompileAction(const nlohmann::json& actionConfig, bool resolve)
+{
+    CompiledAction compiled;
+    const std::string type = actionConfig.value("type", "");
+    compiled.value = actionConfig.value("value", "");
+    compiled.continueToNext = ShouldEvaluateNext(actionConfig);
+
+    compiled.conditions = m_evaluator.CompileConditions(actionConfig, resolve);
+
+    // "acceleration": [{"velocity": 8, "multiplier": 2}, {"velocity": 16, "multiplier": 5}]
+    if (actionConfig.contains("acceleration") && actionConfig["acceleration"].is_array()) {
+        for (const auto& step : actionConfig["acceleration"]) {
+            if (!step.is_object()) continue;
+            compiled.acceleration.push_back({step.value("velocity", 0.0f), step.value("multiplier", 1.0f)});
+        }
+        // The first step listed for a threshold wins
+        std::stable_sort(compiled.acceleration.begin(), compiled.acceleration.end(),
+                         [](const AccelerationStep& a, const AccelerationStep& b) { return a.velocity < b.velocity; });
+        compiled.acceleration.erase(
+            std::unique(compiled.acceleration.begin(), compiled.acceleration.end(),
+                        [](const AccelerationStep& a, const AccelerationStep& b) { return a.velocity == b.velocity; }),
+            compiled.acceleration.end());
+    }
+
+    if (type == "command") {
+        compiled.type = ActionType::Command;
+        compiled.sendCount = std::abs(actionConfig.value("send-count", 1));
+        compiled.merge = actionConfig.value("merge", false);
     } else if (type == "dataref-set") {
-        auto info = ::ParseDataRef(value);
-        if (void* drRef = m_sdk.FindDataRef(info.name.c_str())) {
-            if (!actionConfig.contains("adjustment")) {
-                IFR1_LOG_ERROR(m_sdk, "dataref-set action for '{}' is missing required 'adjustment' key", value);
-            } else {
-                float adj = actionConfig["adjustment"].get<float>();
-                IFR1_LOG_VERBOSE(m_sdk, "Setting dataref: {} to {}", value, adj);
-                int types = m_sdk.GetDataRefTypes(drRef);
-                if (info.index != -1) {
-                    if (types & static_cast<int>(DataRefType::IntArray)) {
-                        m_sdk.SetDataiArray(drRef, static_cast<int>(adj), info.index);
-                    } else {
-                        m_sdk.SetDatafArray(drRef, adj, info.index);
-                    }
-                } else {
-                    if (types & static_cast<int>(DataRefType::Int)) {
-                        m_sdk.SetDatai(drRef, static_cast<int>(adj));
-                    } else {
-                        m_sdk.SetDataf(drRef, adj);
-                    }
-                }
-            }
-        } else {
-            IFR1_LOG_ERROR(m_sdk, "DataRef not found: {}", value);
+        if (!actionConfig.contains("adjustment")) {
+            IFR1_LOG_ERROR(m_sdk, "dataref-set action for '{}' is missing required 'adjustment' key", compiled.value);
+            return compiled;
         }
-    } else if (type == "sound") {
-        std::string fullPath = m_sdk.GetSystemPath() + value;
-        m_sdk.PlaySound(fullPath);
+        compiled.type = ActionType::DataRefSet;
+        compiled.adjustment = actionConfig["adjustment"].get<float>();
     } else if (type == "dataref-adjust") {
-        auto info = ::ParseDataRef(value);
-        if (void* drRef = m_sdk.FindDataRef(info.name.c_str())) {
-            int types = m_sdk.GetDataRefTypes(drRef);
-            float current = 0.0f;
-            bool isInt = false;
-
-            if (info.index != -1) {
-                isInt = (types & static_cast<int>(DataRefType::IntArray));
-                if (isInt) {
-                    current = static_cast<float>(m_sdk.GetDataiArray(drRef, info.index));
-                } else {
-                    current = m_sdk.GetDatafArray(drRef, info.index);
-                }
-            } else {
-                isInt = (types & static_cast<int>(DataRefType::Int));
-                if (isInt) {
-                    current = static_cast<float>(m_sdk.GetDatai(drRef));
-                } else {
-                    current = m_sdk.GetDataf(drRef);
-                }
-            }
+        compiled.type = ActionType::DataRefAdjust;
+        compiled.adjustment = actionConfig.value("adjustment", 0.0f);
+        if (actionConfig.contains("min") && actionConfig.contains("max")) {
+            compiled.minValue = actionConfig["min"].get<float>();
+            compiled.maxValue = actionConfig["max"].get<float>();
+            compiled.limitType = actionConfig.value("limit-type", "clamp") == "wrap" ? LimitType::Wrap : LimitType::Clamp;
+        }
+    } else if (type == "sound") {
+        compiled.type = ActionType::Sound;
+        compiled.value = m_sdk.GetSystemPath() + compiled.value;
+        // Starts the file loading now so the first play does not wait for the disk
+        compiled.sound = m_sdk.LoadSound(compiled.value);
+        return compiled;
+    } else if (type == "sequence") {
+        CompileSequence(actionConfig, compiled, resolve);
+        return compiled;
+    } else if (type == "hold") {
+        compiled.type = ActionType::Hold;
+    } else if (type == "repeat") {
+        // {"type": "repeat", "action": {...}, "rate-hz": 10, "delay-ms": 500}
+        if (!actionConfig.contains("action") || !actionConfig["action"].is_object()) {
+            IFR1_LOG_ERROR(m_sdk, "repeat action is missing its 'action' object");
+            return compiled;
+        }
+        const float rate = actionConfig.value("rate-hz", kDefaultRepeatRateHz);
+        if (rate <= 0.0f) {
+            IFR1_LOG_ERROR(m_sdk, "repeat action 'rate-hz' must be greater than 0");
+            return compiled;
+        }
+        compiled.type = ActionType::Repeat;
+        compiled.repeated = std::make_shared<CompiledAction>(CompileAction(actionConfig["action"], resolve));
+        compiled.repeatInterval = 1.0f / rate;
+        compiled.repeatDelay = std::max(actionConfig.value("delay-ms", kDefaultRepeatDelayMs), 0.0f) / 1000.0f;
+        return compiled;
+    } else {
+        return compiled;
+    }
 
-            float adj = actionConfig.value("adjustment", 0.0f);
-            float next = current + adj;
-
-            if (actionConfig.contains("min") && actionConfig.contains("max")) {
-                float minVal = actionConfig["min"].get<float>();
-                float maxVal = actionConfig["max"].get<float>();
-                std::string limitType = actionConfig.value("limit-type", "clamp");
-
-                if (limitType == "wrap") {
-                    // +1.0f accounts for discrete-step ranges (e.g. heading 0–359
-                    // has 360 steps, so the wrap range is 360, not 359).
-                    float range = maxVal - minVal + 1.0f;
-                    while (next < minVal) next += range;
-                    while (next > maxVal) next -= range;
-                } else {
-                    next = std::clamp(next, minVal, maxVal);
-                }
-            }
+    if (compiled.type != ActionType::Command && compiled.type != ActionType::Hold) {
+        // The registry looks the dataref up once and retries it if it is missing
+        auto info = ::ParseDataRef(compiled.value);
+        compiled.dataRef = m_dataRefs.Intern(info.name);
+        compiled.index = info.index;
+        if (resolve) m_dataRefs.Resolve(compiled.dataRef);
+    } else if (resolve && !ResolveCommand(compiled)) {
+        // Plugins may publish their commands after the config loads,
+        // so the lookup is retried when the action first runs
+        IFR1_LOG_VERBOSE(m_sdk, "'{}' not found yet; will retry when used", compiled.value);
+    }
+    return compiled;
+}
 
-            IFR1_LOG_VERBOSE(m_sdk, "Adjusting dataref: {} (current: {}, adj: {}) -> {}", value, current, adj, next);
+void EventProcessor::CompileSequence(const nlohmann::json& actionConfig, CompiledAction& compiled, bool resolve)
+{
+    if (!actionConfig.contains("steps") || !actionConfig["steps"].is_array()) {
+        IFR1_LOG_ERROR(m_sdk, "sequence action is missing its 'steps' array");
+        return;
+    }
 
-            if (info.index != -1) {
-                if (isInt) {
-                    m_sdk.SetDataiArray(drRef, static_cast<int>(std::round(next)), info.index);
-                } else {
-                    m_sdk.SetDatafArray(drRef, next, info.index);
-                }
-            } else {
-                if (isInt) {
-                    m_sdk.SetDatai(drRef, static_cast<int>(std::round(next)));
-                } else {
-                    m_sdk.SetDataf(drRef, next);
-                }
-            }
+    auto program = std::make_shared<SequenceProgram>();
+    std::vector<ConditionDependency> dependencies;
+    for (const auto& stepConfig : actionConfig["steps"]) {
+        if (!stepConfig.is_object()) continue;
+        SequenceStep step;
+        if (stepConfig.contains("wait-ms")) {
+            step.kind = SequenceStep::Kind::Wait;
+            step.seconds = stepConfig["wait-ms"].get<float>() / 1000.0f;
+        } else if (stepConfig.contains("wait-until")) {
+            step.kind = SequenceStep::Kind::WaitUntil;
+            step.condition = m_evaluator.CompileCondition(stepConfig["wait-until"], resolve);
+            step.seconds = stepConfig.value("timeout-ms", 0.0f) / 1000.0f;
+        } else {
+            step.action = CompileAction(stepConfig, resolve);
+        }
+        ConditionEvaluator::CollectDependencies(step.condition, dependencies);
+        CollectDependencies(step.action, dependencies);
+        program->steps.push_back(std::move(step));
+    }
+    ConditionEvaluator::GroupArrayReads(dependencies, program->arrayWindows);
+    compiled.type = ActionType::Sequence;
+    compiled.sequence = std::move(program);
+}
+
+void EventProcessor::CollectDependencies(const CompiledAction& action, std::vector<ConditionDependency>& out)
+{
+    // A nested sequence prefetches its own windows when it runs
+    ConditionEvaluator::CollectDependencies(action.conditions, out);
+    if (action.repeated) CollectDependencies(*action.repeated, out);
+}
+
+bool EventProcessor::ResolveCommand(CompiledAction& action)
+{
+    action.command = m_sdk.FindCommand(action.value.c_str());
+    return action.command != nullptr;
+}
+
+CommandPriority EventProcessor::PriorityOf(EventId::Action action)
+{
+    return (action == EventId::Action::SHORT_PRESS || action == EventId::Action::LONG_PRESS ||
+            action == EventId::Action::PRESS) ? CommandPriority::High : CommandPriority::Normal;
+}
+
+void EventProcessor::RunPlan(ActionPlan& plan, int count, float velocity, CommandPriority priority)
+{
+    const bool verbose = m_sdk.GetLogLevel() >= LogLevel::Verbose;
+    for (auto& action : plan) {
+        if (!m_evaluator.Evaluate(action.conditions, verbose)) continue;
+        ExecuteAction(action, count, velocity, priority);
+        if (!action.continueToNext) break;
+    }
+}
+
+float EventProcessor::GetAccelerationMultiplier(const CompiledAction& action, float velocity)
+{
+    // The multiplier of the fastest step the knob has reached applies; below
+    // the first step the action runs at its normal rate.
+    float multiplier = 1.0f;
+    for (const auto& step : action.acceleration) {
+        if (velocity < step.velocity) break;
+        multiplier = step.multiplier;
+    }
+    return multiplier;
+}
+
+void EventProcessor::ExecuteAction(CompiledAction& action, int count, float velocity, CommandPriority priority)
+{
+    if (action.type == ActionType::None) return;
+    if (action.type == ActionType::Sound) {
+        m_sdk.PlaySound(action.sound);
+        return;
+    }
+    if (action.type == ActionType::Sequence) {
+        StartSequence(action, priority);
+        return;
+    }
+    if (action.type == ActionType::Repeat) {
+        StartRepeat(action, priority);
+        return;
+    }
+
+    void* ref = nullptr;
+    bool isInt = false;
+    if (action.type == ActionType::Command || action.type == ActionType::Hold) {
+        if (!action.command && !ResolveCommand(action)) {
+            IFR1_LOG_ERROR(m_sdk, "Command not found: {}", action.value);
+            return;
+        }
+        ref = action.command;
+    } else {
+        // A button press is worth a lookup even while the registry is backing off
+        ref = m_dataRefs.Resolve(action.dataRef, true);
+        if (!ref) {
+            IFR1_LOG_ERROR(m_sdk, "DataRef not found: {}", action.value);
+            return;
+        }
+        auto intType = action.index != -1 ? DataRefType::IntArray : DataRefType::Int;
+        isInt = (m_dataRefs.GetTypes(action.dataRef) & static_cast<int>(intType)) != 0;
+    }
+
+    const float scale = static_cast<float>(count) * GetAccelerationMultiplier(action, velocity);
+
+    switch (action.type) {
+    case ActionType::Command: {
+        int times = static_cast<int>(std::lround(static_cast<float>(action.sendCount) * scale));
+        if (times > 0) {
+            IFR1_LOG_VERBOSE(m_sdk, "Queueing command: {} ({} times)", action.value, times);
+            m_commands.Enqueue(ref, times, priority, action.merge);
         } else {
-            IFR1_LOG_ERROR(m_sdk, "DataRef not found: {}", value);
+            IFR1_LOG_VERBOSE(m_sdk, "Skipping command: {} (send-count is 0)", action.value);
+        }
+        break;
+    }
+    case ActionType::Hold: {
+        if (m_pressing == EventId::Control::COUNT) {
+            // Not started by a press, so no release will end it
+            IFR1_LOG_VERBOSE(m_sdk, "Queueing command: {} (hold outside a press event)", action.value);
+            m_commands.Enqueue(ref, 1, priority, false);
+            break;
+        }
+        IFR1_LOG_VERBOSE(m_sdk, "Holding command: {}", action.value);
+        m_sdk.CommandBegin(ref);
+        m_holds.push_back(ActiveHold{m_pressing, ref, 0, nullptr, 0.0f, priority});
+        break;
+    }
+    case ActionType::DataRefSet: {
+        const float adj = action.adjustment;
+        IFR1_LOG_VERBOSE(m_sdk, "Setting dataref: {} to {}", action.value, adj);
+        m_dataRefs.WriteValue(action.dataRef, action.index, adj);
+        break;
+    }
+    case ActionType::DataRefAdjust: {
+        const auto current = static_cast<float>(m_dataRefs.ReadValue(action.dataRef, action.index));
+
+        // All coalesced detents are applied in a single read-modify-write
+        float adj = action.adjustment * scale;
+        float next = current + adj;
+
+        if (action.limitType == LimitType::Wrap) {
+            // +1.0f accounts for discrete-step ranges (e.g. heading 0–359
+            // has 360 steps, so the wrap range is 360, not 359).
+            float range = action.maxValue - action.minValue + 1.0f;
+            while (next < action.minValue) next += range;
+            while (next > action.maxValue) next -= range;
+        } else if (action.limitType == LimitType::Clamp) {
+            next = std::clamp(next, action.minValue, action.maxValue);
         }
+
+        IFR1_LOG_VERBOSE(m_sdk, "Adjusting dataref: {} (current: {}, adj: {}) -> {}", action.value, current, adj, next);
+
+        // Inside a frame the registry holds the write, so further adjustments
+        // this frame build on `next` and the SDK sees only the final value
+        m_dataRefs.WriteValue(action.dataRef, action.index, isInt ? std::round(next) : next);
+        break;
+    }
+    default:
+        break;
     }
 }
 
@@ -235,11 +457,148 @@ bool EventProcessor::ShouldEvaluateNext(const nlohmann::json& actionConfig)
     return false;
 }
 
-void EventProcessor::ProcessQueue()
+void EventProcessor::StartSequence(const CompiledAction& action, CommandPriority priority)
 {
-    if (!m_commandQueue.empty()) {
-        void* cmdRef = m_commandQueue.front();
-        m_commandQueue.pop();
-        m_sdk.CommandOnce(cmdRef);
+    if (!action.sequence) return;
+    // Triggering a sequence that is still running restarts it
+    for (auto& running : m_sequences) {
+        if (running.program == action.sequence) running.program.reset();
     }
+    IFR1_LOG_VERBOSE(m_sdk, "Starting sequence: {} steps", action.sequence->steps.size());
+    m_sequences.push_back(RunningSequence{action.sequence, 0, -1.0f, priority});
+}
+
+void EventProcessor::RunSequences()
+{
+    const float now = m_sdk.GetElapsedTime();
+    // Sequences started by a step are appended and begin in this same pass
+    for (size_t slot = 0; slot < m_sequences.size(); ++slot) {
+        AdvanceSequence(slot, now);
+    }
+    std::erase_if(m_sequences, [](const RunningSequence& running) { return !running.program; });
+}
+
+void EventProcessor::AdvanceSequence(size_t slot, float now)
+{
+    const bool verbose = m_sdk.GetLogLevel() >= LogLevel::Verbose;
+    if (const auto& program = m_sequences[slot].program) m_evaluator.PrefetchArrays(program->arrayWindows);
+    // The local copy keeps the steps alive if a step restarts this sequence
+    while (auto program = m_sequences[slot].program) {
+        RunningSequence& running = m_sequences[slot];
+        if (running.nextStep >= program->steps.size()) {
+            running.program.reset();
+            return;
+        }
+
+        SequenceStep& step = program->steps[running.nextStep];
+        if (step.kind == SequenceStep::Kind::Action) {
+            ++running.nextStep;
+            // May start another sequence, which invalidates `running`
+            const CommandPriority priority = running.priority;
+            if (m_evaluator.Evaluate(step.action.conditions, verbose)) {
+                ExecuteAction(step.action, 1, 0.0f, priority);
+            }
+            continue;
+        }
+
+        if (running.waitStart < 0.0f) running.waitStart = now;
+        const float waited = now - running.waitStart;
+        if (step.kind == SequenceStep::Kind::Wait) {
+            if (waited < step.seconds) return;
+        } else if (!m_evaluator.Evaluate(step.condition, verbose)) {
+            if (step.seconds > 0.0f && waited >= step.seconds) {
+                IFR1_LOG_VERBOSE(m_sdk, "Sequence cancelled: condition not met within {}s", step.seconds);
+                running.program.reset();
+            }
+            return;
+        }
+        ++running.nextStep;
+        running.waitStart = -1.0f;
+    }
+}
+
+void EventProcessor::CancelSequences()
+{
+    if (m_sequences.empty()) return;
+    IFR1_LOG_VERBOSE(m_sdk, "Cancelling {} running sequence(s)", m_sequences.size());
+    m_sequences.clear();
+}
+
+void EventProcessor::StartRepeat(const CompiledAction& action, CommandPriority priority)
+{
+    if (!action.repeated) return;
+    const EventId::Control control = m_pressing;
+    RunRepeated(*action.repeated, priority);
+    if (control == EventId::Control::COUNT) return;
+
+    if (++m_lastTimerKey == 0) ++m_lastTimerKey;
+    IFR1_LOG_VERBOSE(m_sdk, "Repeating every {}s until {} is released", action.repeatInterval, EventId::ControlName(control));
+    m_holds.push_back(ActiveHold{control, nullptr, m_lastTimerKey, action.repeated, action.repeatInterval, priority});
+    m_timers.Schedule(m_lastTimerKey, m_sdk.GetElapsedTime(), action.repeatDelay);
+}
+
+void EventProcessor::RunRepeated(CompiledAction& action, CommandPriority priority)
+{
+    // A hold or repeat nested inside a repeat would have no release to end it
+    const EventId::Control pressing = std::exchange(m_pressing, EventId::Control::COUNT);
+    if (m_evaluator.Evaluate(action.conditions, m_sdk.GetLogLevel() >= LogLevel::Verbose)) {
+        ExecuteAction(action, 1, 0.0f, priority);
+    }
+    m_pressing = pressing;
+}
+
+void EventProcessor::RunTimers()
+{
+    const float now = m_sdk.GetElapsedTime();
+    m_timers.Advance(now, [&](uint32_t key) {
+        auto hold = std::find_if(m_holds.begin(), m_holds.end(),
+                                 [key](const ActiveHold& h) { return h.timerKey == key; });
+        // Released since the timer was armed
+        if (hold == m_holds.end()) return;
+        const auto repeated = hold->repeated;
+        const float interval = hold->interval;
+        RunRepeated(*repeated, hold->priority);
+        m_timers.Schedule(key, now, interval);
+    });
+}
+
+void EventProcessor::EndHold(const ActiveHold& hold)
+{
+    // A repeat needs nothing here; its timer is ignored once the hold is gone
+    if (!hold.command) return;
+    IFR1_LOG_VERBOSE(m_sdk, "Releasing held command for {}", EventId::ControlName(hold.control));
+    m_sdk.CommandEnd(hold.command);
+}
+
+void EventProcessor::ReleaseControl(EventId::Control control)
+{
+    if (m_holds.empty()) return;
+    std::erase_if(m_holds, [&](const ActiveHold& hold) {
+        if (hold.control != control) return false;
+        EndHold(hold);
+        return true;
+    });
+}
+
+void EventProcessor::ReleaseAllControls()
+{
+    for (const auto& hold : m_holds) {
+        EndHold(hold);
+    }
+    m_holds.clear();
+    m_timers.Clear();
+}
+
+void EventProcessor::ProcessQueue()
+{
+    // Repeats and sequences first, so the commands they queue run this frame
+    if (!m_timers.Empty()) RunTimers();
+    if (!m_sequences.empty()) RunSequences();
+    // Held dataref writes go out before the commands, which may depend on them
+    m_dataRefs.FlushWrites();
+
+    const auto executed = m_commands.GetStats().executed;
+    m_commands.RunFrame();
+    // A command can change any dataref, so the value snapshot is stale
+    if (m_commands.GetStats().executed != executed) m_dataRefs.InvalidateValues();
 }
@@ -18,47 +18,176 @@
 #include "XPlaneSDK.h"
 #include <nlohmann/json.hpp>
 #include <string>
-#include <queue>
-#include <unordered_map>
 #include "ConditionEvaluator.h"
+#include "ActionPlan.h"
+#include "CommandScheduler.h"
+#include "EventIds.h"
+#include "TimerWheel.h"
+#include <array>
+#include <memory>
+#include <vector>
 
 class EventProcessor {
 public:
-    explicit EventProcessor(IXPlaneSDK& sdk) : m_sdk(sdk), m_evaluator(sdk) {}
+    /** @brief Uses a private DataRefRegistry. */
+    explicit EventProcessor(IXPlaneSDK& sdk)
+        : m_sdk(sdk), m_ownedDataRefs(std::make_unique<DataRefRegistry>(sdk)), m_dataRefs(*m_ownedDataRefs),
+          m_evaluator(sdk, m_dataRefs), m_commands(sdk) {}
+
+    EventProcessor(IXPlaneSDK& sdk, DataRefRegistry& dataRefs)
+        : m_sdk(sdk), m_dataRefs(dataRefs), m_evaluator(sdk, dataRefs), m_commands(sdk) {}
 
     /**
      * @brief Processes an input event based on the current configuration.
      * @param config The current aircraft configuration JSON.
-     * @param mode The current mode (e.g., "com1").
-     * @param control The control being used (e.g., "inner-knob").
-     * @param action The action performed (e.g., "rotate-clockwise").
+     * @param mode The current mode ID, from EventId::ModeOf().
+     * @param control The control being used (e.g., EventId::Control::INNER_KNOB).
+     * @param action The action performed (e.g., EventId::Action::ROTATE_CLOCKWISE).
+     * @param count Number of times the event occurred (knob detents coalesced
+     *        into one dispatch).  Conditions are evaluated once for all of them.
+     * @param velocity Knob speed in detents per second, used to pick the
+     *        multiplier from an action's optional "acceleration" curve.
+     */
+    void ProcessEvent(const nlohmann::json& config,
+                      uint8_t mode,
+                      EventId::Control control,
+                      EventId::Action action,
+                      int count = 1,
+                      float velocity = 0.0f);
+
+    /**
+     * @brief Convenience overload taking the names used in the config.
+     * Names with no EventId are ignored once the config has been prepared.
      */
-    void ProcessEvent(const nlohmann::json& config, 
-                      const std::string& mode, 
-                      const std::string& control, 
-                      const std::string& action);
+    void ProcessEvent(const nlohmann::json& config,
+                      const std::string& mode,
+                      const std::string& control,
+                      const std::string& action,
+                      int count = 1,
+                      float velocity = 0.0f);
 
     /**
-     * @brief Pre-computes a flat lookup map from the aircraft configuration.
-     * Call this whenever the aircraft configuration changes.  ProcessEvent will
-     * use the map for O(1) dispatch instead of traversing the JSON hierarchy.
+     * @brief Compiles the aircraft configuration into one ActionPlan per event.
+     * Call this whenever the aircraft configuration changes.  Plans are stored
+     * in a dense table indexed by mode, control and action ID.  Action types,
+     * limits and acceleration curves are decoded, command handles looked up
+     * and datarefs interned in the DataRefRegistry here, so ProcessEvent runs
+     * the plan without re-reading the JSON or asking the SDK again.  Without
+     * it ProcessEvent compiles the event it is given on every call.  Running
+     * sequences are cancelled and held commands released.
      * @param config The full aircraft configuration JSON.
      */
     void PrepareConfig(const nlohmann::json& config);
 
     /**
-     * @brief Processes one command from the FIFO queue.
-     * Should be called once per frame.
+     * @brief Ends the "hold" and "repeat" actions started by pressing `control`.
+     * Call when the button is released.
+     */
+    void ReleaseControl(EventId::Control control);
+
+    /**
+     * @brief Ends every hold and repeat, e.g. when the mode selector is turned
+     * or the device goes away.
+     */
+    void ReleaseAllControls();
+
+    /** @brief Number of holds and repeats waiting for their button to be released. */
+    [[nodiscard]] size_t GetActiveHoldCount() const { return m_holds.size(); }
+
+    /**
+     * @brief Fires due repeats, advances running sequences and runs queued
+     * commands within the per-frame budget.
+     * Button presses run before queued knob ticks.  Should be called once per frame.
      */
     void ProcessQueue();
 
+    /**
+     * @brief Stops every running sequence, e.g. when the mode selector is turned.
+     * Steps already run are not undone.
+     */
+    void CancelSequences();
+
+    /** @brief Number of sequences still running. */
+    [[nodiscard]] size_t GetActiveSequenceCount() const { return m_sequences.size(); }
+
+    /**
+     * @brief Queue depth, merge and drop counters for the command scheduler.
+     */
+    [[nodiscard]] CommandScheduler::Stats GetCommandStats() const { return m_commands.GetStats(); }
+
 private:
     IXPlaneSDK& m_sdk;
+    std::unique_ptr<DataRefRegistry> m_ownedDataRefs;
+    DataRefRegistry& m_dataRefs;
     ConditionEvaluator m_evaluator;
-    std::queue<void*> m_commandQueue;
-    // Keyed by "mode\x1Fcontrol\x1Faction"; populated by PrepareConfig
-    std::unordered_map<std::string, nlohmann::json> m_actionMap;
+    CommandScheduler m_commands;
 
-    void ExecuteAction(const nlohmann::json& actionConfig);
+    // Populated by PrepareConfig.  m_dispatch holds one slot per
+    // (mode, control, action) and points into m_plans, or is null if the
+    // config does not map that event.
+    static constexpr size_t kControlCount = static_cast<size_t>(EventId::Control::COUNT);
+    static constexpr size_t kActionCount = static_cast<size_t>(EventId::Action::COUNT);
+    static constexpr size_t kDispatchSize = EventId::MODE_COUNT * kControlCount * kActionCount;
+    bool m_prepared = false;
+    std::vector<PreparedPlan> m_plans;
+    std::array<PreparedPlan*, kDispatchSize> m_dispatch{};
+
+    // A sequence action in progress.  Empty unless a sequence is running, so
+    // ProcessQueue costs nothing extra otherwise.
+    struct RunningSequence {
+        std::shared_ptr<SequenceProgram> program;   // Reset when the sequence finishes or is cancelled
+        size_t nextStep = 0;
+        float waitStart = -1.0f;                    // Time the current wait began; -1 if not waiting
+        CommandPriority priority = CommandPriority::Normal;
+    };
+    std::vector<RunningSequence> m_sequences;
+
+    // A "hold" or "repeat" started by a press event, ended by ReleaseControl.
+    // Repeats wait in m_timers, so frames where no repeat is due cost nothing.
+    static constexpr float kDefaultRepeatRateHz = 10.0f;
+    static constexpr float kDefaultRepeatDelayMs = 500.0f;
+    struct ActiveHold {
+        EventId::Control control = EventId::Control::COUNT;
+        void* command = nullptr;                    // "hold": the command to end on release
+        uint32_t timerKey = 0;                      // "repeat": key of its timer; never 0
+        std::shared_ptr<CompiledAction> repeated;
+        float interval = 0.0f;
+        CommandPriority priority = CommandPriority::Normal;
+    };
+    std::vector<ActiveHold> m_holds;
+    TimerWheel m_timers;
+    uint32_t m_lastTimerKey = 0;
+    // Control whose press event is running; COUNT outside one
+    EventId::Control m_pressing = EventId::Control::COUNT;
+
+    static size_t DispatchIndex(uint8_t mode, EventId::Control control, EventId::Action action);
+    /** @brief Traverses the JSON when PrepareConfig has not been called. */
+    void ProcessUnpreparedEvent(const nlohmann::json& config, std::string_view mode, std::string_view control,
+                                std::string_view action, int count, float velocity);
+
+    /**
+     * @brief Compiles the "actions" array of one event.
+     * @param resolve Look up handles now; otherwise the first execution does.
+     */
+    ActionPlan CompileEvent(const nlohmann::json& eventConfig, std::string_view mode,
+                            std::string_view control, std::string_view action, bool resolve);
+    CompiledAction CompileAction(const nlohmann::json& actionConfig, bool resolve);
+    /** @brief Looks up the command handle; returns false if it does not exist (yet). */
+    bool ResolveCommand(CompiledAction& action);
+    void CompileSequence(const nlohmann::json& actionConfig, CompiledAction& compiled, bool resolve);
+    /** @brief Appends the dataref elements the conditions of `action` and its repeated action read. */
+    static void CollectDependencies(const CompiledAction& action, std::vector<ConditionDependency>& out);
+    void RunPlan(ActionPlan& plan, int count, float velocity, CommandPriority priority);
+    void StartSequence(const CompiledAction& action, CommandPriority priority);
+    void RunSequences();
+    /** @brief Runs the sequence in m_sequences[slot] until it waits or ends. */
+    void AdvanceSequence(size_t slot, float now);
+    void StartRepeat(const CompiledAction& action, CommandPriority priority);
+    void RunRepeated(CompiledAction& action, CommandPriority priority);
+    void RunTimers();
+    void EndHold(const ActiveHold& hold);
+    void ExecuteAction(CompiledAction& action, int count, float velocity, CommandPriority priority);
+    static CommandPriority PriorityOf(EventId::Action action);
+    static float GetAccelerationMultiplier(const CompiledAction& action, float velocity);
     static bool ShouldEvaluateNext(const nlohmann::json& actionConfig);
 };
@@ -15,10 +15,21 @@
  */
 
 #include "HIDManager.h"
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <mutex>
 
-HIDManager::HIDManager() : m_device(nullptr) {
-    if (hid_init() != 0) {
+namespace {
+
+// hid_init/hid_exit manage process-wide hidapi state, so they run only for
+// the first and last user while other units still have devices open
+std::mutex gHidApiMutex;
+int gHidApiUsers = 0;
+
+void AcquireHidApi() {
+    std::lock_guard<std::mutex> lock(gHidApiMutex);
+    if (gHidApiUsers++ == 0 && hid_init() != 0) {
         // hid_init failing typically means HIDAPI could not initialize the
         // platform HID backend.  Subsequent hid_open calls will fail and the
         // plugin will report the device as not connected.
@@ -26,46 +37,124 @@ HIDManager::HIDManager() : m_device(nullptr) {
     }
 }
 
+void ReleaseHidApi() {
+    std::lock_guard<std::mutex> lock(gHidApiMutex);
+    if (--gHidApiUsers == 0) {
+        hid_exit();
+    }
+}
+
+// IFR-1 serial numbers are plain ASCII, so a per-character conversion is enough
+std::string Narrow(const wchar_t* wide) {
+    std::string result;
+    for (; wide && *wide; ++wide) {
+        result += static_cast<char>(*wide);
+    }
+    return result;
+}
+
+} // namespace
+
+HIDManager::HIDManager(std::string serial) : m_serial(std::move(serial)) {
+    AcquireHidApi();
+}
+
 HIDManager::~HIDManager() {
     HIDManager::Disconnect();
-    hid_exit();
+    ReleaseHidApi();
 }
 
-bool HIDManager::Connect(uint16_t vendorId, uint16_t productId) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    DisconnectInternal();
-    m_device = hid_open(vendorId, productId, nullptr);
-    if (m_device) {
-        hid_set_nonblocking(m_device, 0);
+std::vector<std::string> HIDManager::EnumerateSerials(uint16_t vendorId, uint16_t productId) {
+    std::vector<std::string> serials;
+    AcquireHidApi();
+    hid_device_info* devices = hid_enumerate(vendorId, productId);
+    for (hid_device_info* info = devices; info; info = info->next) {
+        std::string serial = Narrow(info->serial_number);
+        // A unit can expose several interfaces; list each physical device once
+        if (std::find(serials.begin(), serials.end(), serial) == serials.end()) {
+            serials.push_back(std::move(serial));
+        }
     }
-    return m_device != nullptr;
+    hid_free_enumeration(devices);
+    ReleaseHidApi();
+    return serials;
 }
 
-void HIDManager::Disconnect() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    DisconnectInternal();
+bool HIDManager::Connect(uint16_t vendorId, uint16_t productId) {
+    Disconnect();
+    m_vendorId = vendorId;
+    m_productId = productId;
+    std::wstring wideSerial(m_serial.begin(), m_serial.end());
+    hid_device* device = hid_open(vendorId, productId, m_serial.empty() ? nullptr : wideSerial.c_str());
+    if (!device) return false;
+
+    hid_set_nonblocking(device, 0);
+    m_device.reset(device);
+    return true;
 }
 
-void HIDManager::DisconnectInternal() {
-    if (m_device) {
-        hid_close(m_device);
-        m_device = nullptr;
-    }
+void HIDManager::Disconnect() {
+    m_device.reset();
+    m_pendingResult = 0;
 }
 
 bool HIDManager::IsConnected() const {
-    std::lock_guard<std::mutex> lock(m_mutex);
     return m_device != nullptr;
 }
 
 int HIDManager::Read(uint8_t* data, size_t length, int timeoutMs) {
-    std::lock_guard<std::mutex> lock(m_mutex);
     if (!m_device) return -1;
-    return hid_read_timeout(m_device, data, length, timeoutMs);
+
+    if (m_pendingResult != 0) {
+        const int result = m_pendingResult;
+        m_pendingResult = 0;
+        if (result < 0) return result;
+        const size_t bytes = std::min(length, static_cast<size_t>(result));
+        std::copy_n(m_pendingReport.begin(), bytes, data);
+        return static_cast<int>(bytes);
+    }
+    return hid_read_timeout(m_device.get(), data, length, timeoutMs);
 }
 
 int HIDManager::Write(const uint8_t* data, size_t length) {
-    std::lock_guard<std::mutex> lock(m_mutex);
     if (!m_device) return -1;
-    return hid_write(m_device, data, length);
+    return hid_write(m_device.get(), data, length);
+}
+
+void HIDManager::WaitForInput(int timeoutMs) {
+    if (!m_device || m_pendingResult != 0) return;
+
+    // A report or a read error ends the wait; Read() hands it over
+    m_pendingResult = WaitInSlices(m_wakeRequested, timeoutMs, [this](int sliceMs) {
+        return hid_read_timeout(m_device.get(), m_pendingReport.data(), m_pendingReport.size(), sliceMs);
+    });
+}
+
+int HIDManager::WaitInSlices(std::atomic<bool>& wake, int timeoutMs, const std::function<int(int sliceMs)>& read) {
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    while (!wake.exchange(false)) {
+        int sliceMs = kWaitSliceMs;
+        if (timeoutMs >= 0) {
+            auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now());
+            if (remaining.count() <= 0) return 0;
+            sliceMs = std::min(sliceMs, static_cast<int>(remaining.count()));
+        }
+        if (const int result = read(sliceMs); result != 0) return result;
+    }
+    return 0;
+}
+
+void HIDManager::Wake() {
+    m_wakeRequested = true;
+}
+
+void HIDManager::Shutdown() {
+    Wake();
+    m_hotplug.Wake();
+}
+
+void HIDManager::WaitForDevice(int timeoutMs) {
+    m_hotplug.WaitForDevice(m_vendorId, m_productId, timeoutMs);
 }
@@ -16,15 +16,39 @@
 
 #pragma once
 #include "IHardwareManager.h"
+#include "HotplugMonitor.h"
 #include <hidapi/hidapi.h>
 
-#include <mutex>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
 
+/**
+ * @brief hidapi backend.
+ *
+ * hidapi can only block on the device itself, so WaitForInput() blocks in
+ * kWaitSliceMs reads and checks for Wake() between them.  A report that
+ * arrives during the wait is kept for the next Read().  An idle device
+ * therefore wakes the worker no more often than the old 20 ms poll, and an
+ * LED write waits at most one slice.  Every device call
+ * comes from the DeviceHandler worker thread; only Wake() and Shutdown() are
+ * called from other threads.
+ */
 class HIDManager : public IHardwareManager {
 public:
-    HIDManager();
+    /**
+     * @param serial If non-empty, Connect() only opens the unit with this serial number.
+     */
+    explicit HIDManager(std::string serial = "");
     ~HIDManager() override;
 
+    /**
+     * @brief Lists the serial numbers of all attached devices with the given IDs.
+     */
+    static std::vector<std::string> EnumerateSerials(uint16_t vendorId, uint16_t productId);
+
     bool Connect(uint16_t vendorId, uint16_t productId) override;
     void Disconnect() override;
     [[nodiscard]] bool IsConnected() const override;
@@ -32,8 +56,37 @@ public:
     int Read(uint8_t* data, size_t length, int timeoutMs) override;
     int Write(const uint8_t* data, size_t length) override;
 
+    [[nodiscard]] bool CanWaitForInput() const override { return true; }
+    void WaitForInput(int timeoutMs) override;
+    void Wake() override;
+    void Shutdown() override;
+
+    [[nodiscard]] bool SupportsHotplug() const override { return m_hotplug.IsAvailable(); }
+    void WaitForDevice(int timeoutMs) override;
+
+    // Longest a pending Wake() goes unnoticed by WaitForInput()
+    static constexpr int kWaitSliceMs = 20;
+
+    /**
+     * @brief The wait loop behind WaitForInput(): calls `read` with slices of
+     * at most kWaitSliceMs until it returns non-zero, `wake` is set, or
+     * `timeoutMs` (-1 for none) runs out.
+     * @return What the last read returned, or 0 if no read returned a result.
+     */
+    static int WaitInSlices(std::atomic<bool>& wake, int timeoutMs, const std::function<int(int sliceMs)>& read);
+
 private:
-    void DisconnectInternal();
-    hid_device* m_device;
-    mutable std::mutex m_mutex;
+    // Largest report a full-speed HID device can send
+    static constexpr size_t kMaxReportSize = 64;
+
+    std::string m_serial;
+    std::unique_ptr<hid_device, decltype(&hid_close)> m_device{nullptr, hid_close};
+    std::atomic<bool> m_wakeRequested{false};
+    // Result of a read made by WaitForInput(): 0 if none, else what
+    // hid_read_timeout returned, with the report in m_pendingReport
+    int m_pendingResult = 0;
+    std::array<uint8_t, kMaxReportSize> m_pendingReport{};
+    HotplugMonitor m_hotplug;
+    std::atomic<uint16_t> m_vendorId{0};
+    std::atomic<uint16_t> m_productId{0};
 };
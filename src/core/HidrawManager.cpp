@@ -0,0 +1,237 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "HidrawManager.h"
+#include "HIDManager.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace {
+constexpr const char* kHidrawClassPath = "/sys/class/hidraw";
+}
+
+std::optional<HidUeventInfo> ParseHidUevent(const std::string& uevent) {
+    std::optional<HidUeventInfo> info;
+    std::string serial;
+
+    std::istringstream stream(uevent);
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (line.starts_with("HID_UNIQ=")) {
+            serial = line.substr(9);
+            continue;
+        }
+        if (!line.starts_with("HID_ID=")) continue;
+
+        // HID_ID=<bus>:<vendor>:<product>, each field in hex
+        unsigned int bus = 0;
+        unsigned int vendor = 0;
+        unsigned int product = 0;
+        if (std::sscanf(line.c_str() + 7, "%x:%x:%x", &bus, &vendor, &product) != 3) {
+            return std::nullopt;
+        }
+        info = HidUeventInfo{static_cast<uint16_t>(vendor), static_cast<uint16_t>(product), {}};
+    }
+
+    if (info) {
+        info->serial = std::move(serial);
+    }
+    return info;
+}
+
+HidrawManager::DeviceFd::~DeviceFd() {
+    close(fd);
+}
+
+HidrawManager::HidrawManager(std::string serial) : m_serial(std::move(serial)) {
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_epollFd < 0 || m_wakeFd < 0) {
+        fprintf(stderr, "IFR-1 Flex: could not create epoll/eventfd for hidraw backend\n");
+        if (m_wakeFd >= 0) close(m_wakeFd);
+        if (m_epollFd >= 0) close(m_epollFd);
+        m_wakeFd = -1;
+        m_epollFd = -1;
+        return;
+    }
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = m_wakeFd;
+    epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &ev);
+}
+
+HidrawManager::~HidrawManager() {
+    HidrawManager::Disconnect();
+    if (m_wakeFd >= 0) close(m_wakeFd);
+    if (m_epollFd >= 0) close(m_epollFd);
+}
+
+bool HidrawManager::IsSupported() {
+    std::error_code ec;
+    return std::filesystem::is_directory(kHidrawClassPath, ec);
+}
+
+template <typename Fn>
+void HidrawManager::ForEachDevice(Fn&& fn) {
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(kHidrawClassPath, ec)) {
+        std::ifstream file(entry.path() / "device" / "uevent");
+        if (!file) continue;
+
+        std::stringstream contents;
+        contents << file.rdbuf();
+        if (auto info = ParseHidUevent(contents.str())) {
+            fn("/dev/" + entry.path().filename().string(), *info);
+        }
+    }
+}
+
+std::string HidrawManager::FindDevicePath(uint16_t vendorId, uint16_t productId) const {
+    std::string path;
+    ForEachDevice([&](const std::string& devicePath, const HidUeventInfo& info) {
+        if (path.empty() && info.vendorId == vendorId && info.productId == productId &&
+            (m_serial.empty() || info.serial == m_serial)) {
+            path = devicePath;
+        }
+    });
+    return path;
+}
+
+std::vector<std::string> HidrawManager::EnumerateSerials(uint16_t vendorId, uint16_t productId) {
+    std::vector<std::string> serials;
+    ForEachDevice([&](const std::string&, const HidUeventInfo& info) {
+        // A unit can expose several interfaces; list each physical device once
+        if (info.vendorId == vendorId && info.productId == productId &&
+            std::find(serials.begin(), serials.end(), info.serial) == serials.end()) {
+            serials.push_back(info.serial);
+        }
+    });
+    return serials;
+}
+
+bool HidrawManager::Connect(uint16_t vendorId, uint16_t productId) {
+    Disconnect();
+    m_vendorId = vendorId;
+    m_productId = productId;
+
+    std::string path = FindDevicePath(vendorId, productId);
+    if (path.empty()) return false;
+
+    int fd = open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    if (m_epollFd >= 0) {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &ev);
+    }
+    m_device = std::make_unique<DeviceFd>(fd);
+    return true;
+}
+
+void HidrawManager::Disconnect() {
+    if (m_device && m_epollFd >= 0) {
+        epoll_ctl(m_epollFd, EPOLL_CTL_DEL, m_device->fd, nullptr);
+    }
+    m_device.reset();
+}
+
+bool HidrawManager::IsConnected() const {
+    return m_device != nullptr;
+}
+
+int HidrawManager::Read(uint8_t* data, size_t length, int timeoutMs) {
+    if (!m_device) return -1;
+    const int fd = m_device->fd;
+
+    if (timeoutMs != 0) {
+        pollfd pfd{fd, POLLIN, 0};
+        int ready = poll(&pfd, 1, timeoutMs);
+        if (ready < 0) return errno == EINTR ? 0 : -1;
+        if (ready == 0) return 0;
+    }
+
+    ssize_t bytes = read(fd, data, length);
+    if (bytes < 0) {
+        return (errno == EAGAIN || errno == EINTR) ? 0 : -1;
+    }
+    return static_cast<int>(bytes);
+}
+
+int HidrawManager::Write(const uint8_t* data, size_t length) {
+    if (!m_device) return -1;
+
+    ssize_t bytes = write(m_device->fd, data, length);
+    return bytes < 0 ? -1 : static_cast<int>(bytes);
+}
+
+void HidrawManager::WaitForInput(int timeoutMs) {
+    if (m_epollFd < 0) return;
+
+    epoll_event events[2];
+    int count = epoll_wait(m_epollFd, events, 2, timeoutMs);
+    for (int i = 0; i < count; ++i) {
+        if (events[i].data.fd == m_wakeFd) {
+            // Reset the eventfd counter so the next wait blocks again
+            uint64_t value = 0;
+            [[maybe_unused]] ssize_t ignored = read(m_wakeFd, &value, sizeof(value));
+        }
+    }
+}
+
+void HidrawManager::Wake() {
+    if (m_wakeFd < 0) return;
+    uint64_t one = 1;
+    [[maybe_unused]] ssize_t ignored = write(m_wakeFd, &one, sizeof(one));
+}
+
+void HidrawManager::Shutdown() {
+    // Only shutdown pokes the hotplug monitor; waking it for every LED
+    // update would leave a stale wake behind for the next unplug
+    Wake();
+    m_hotplug.Wake();
+}
+
+void HidrawManager::WaitForDevice(int timeoutMs) {
+    m_hotplug.WaitForDevice(m_vendorId, m_productId, timeoutMs);
+}
+
+std::unique_ptr<IHardwareManager> CreateHardwareManager(const std::string& serial) {
+    if (HidrawManager::IsSupported()) {
+        return std::make_unique<HidrawManager>(serial);
+    }
+    return std::make_unique<HIDManager>(serial);
+}
+
+std::vector<std::string> EnumerateHardwareSerials(uint16_t vendorId, uint16_t productId) {
+    if (HidrawManager::IsSupported()) {
+        return HidrawManager::EnumerateSerials(vendorId, productId);
+    }
+    return HIDManager::EnumerateSerials(vendorId, productId);
+}
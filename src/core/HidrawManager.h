@@ -0,0 +1,114 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+#include "IHardwareManager.h"
+#include "HotplugMonitor.h"
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Vendor/product IDs and serial number parsed from a hidraw device's sysfs uevent.
+ */
+struct HidUeventInfo {
+    uint16_t vendorId = 0;
+    uint16_t productId = 0;
+    std::string serial;
+};
+
+/**
+ * @brief Parses the HID_ID line ("HID_ID=0003:000004D8:0000E6D6") and the
+ * HID_UNIQ (serial number) line of a sysfs uevent file.
+ * @return The IDs, or std::nullopt if the text has no well-formed HID_ID line.
+ */
+std::optional<HidUeventInfo> ParseHidUevent(const std::string& uevent);
+
+/**
+ * @brief Linux hidraw backend.
+ *
+ * Talks to /dev/hidrawN directly so the device file descriptor can be placed in
+ * an epoll set together with an eventfd.  WaitForInput() then sleeps in the
+ * kernel until a report arrives or another thread calls Wake(), giving
+ * immediate input delivery with no periodic wakeups while idle.
+ *
+ * Every device call comes from the DeviceHandler worker thread, so the open
+ * descriptor needs no lock; only Wake() and Shutdown() are called from other
+ * threads.
+ */
+class HidrawManager : public IHardwareManager {
+public:
+    /**
+     * @param serial If non-empty, Connect() only opens the unit with this serial number.
+     */
+    explicit HidrawManager(std::string serial = "");
+    ~HidrawManager() override;
+
+    HidrawManager(const HidrawManager&) = delete;
+    HidrawManager& operator=(const HidrawManager&) = delete;
+
+    /**
+     * @brief Whether the running kernel exposes hidraw devices.
+     */
+    [[nodiscard]] static bool IsSupported();
+
+    /**
+     * @brief Lists the serial numbers of all attached devices with the given IDs.
+     */
+    static std::vector<std::string> EnumerateSerials(uint16_t vendorId, uint16_t productId);
+
+    bool Connect(uint16_t vendorId, uint16_t productId) override;
+    void Disconnect() override;
+    [[nodiscard]] bool IsConnected() const override;
+
+    int Read(uint8_t* data, size_t length, int timeoutMs) override;
+    int Write(const uint8_t* data, size_t length) override;
+
+    [[nodiscard]] bool CanWaitForInput() const override { return m_epollFd >= 0; }
+    void WaitForInput(int timeoutMs) override;
+    void Wake() override;
+    void Shutdown() override;
+
+    [[nodiscard]] bool SupportsHotplug() const override { return m_hotplug.IsAvailable(); }
+    void WaitForDevice(int timeoutMs) override;
+
+private:
+    // Closes the descriptor when the device is released
+    struct DeviceFd {
+        explicit DeviceFd(int f) : fd(f) {}
+        ~DeviceFd();
+        DeviceFd(const DeviceFd&) = delete;
+        DeviceFd& operator=(const DeviceFd&) = delete;
+        int fd;
+    };
+
+    // Calls fn(devicePath, info) for every hidraw node whose uevent parses
+    template <typename Fn>
+    static void ForEachDevice(Fn&& fn);
+
+    std::string FindDevicePath(uint16_t vendorId, uint16_t productId) const;
+
+    std::string m_serial;
+    int m_epollFd = -1;
+    int m_wakeFd = -1;
+    std::unique_ptr<DeviceFd> m_device;
+    HotplugMonitor m_hotplug;
+    std::atomic<uint16_t> m_vendorId{0};
+    std::atomic<uint16_t> m_productId{0};
+};
@@ -0,0 +1,132 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "HotplugMonitor.h"
+#include "HidrawManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+
+#include <libudev.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace {
+
+bool MatchesHidId(const char* hidId, const std::vector<std::pair<uint16_t, uint16_t>>& ids) {
+    if (!hidId) return false;
+    auto info = ParseHidUevent(std::string("HID_ID=") + hidId);
+    return info && std::find(ids.begin(), ids.end(), std::pair(info->vendorId, info->productId)) != ids.end();
+}
+
+} // namespace
+
+HotplugMonitor::HotplugMonitor() {
+    m_udev = udev_new();
+    if (!m_udev) return;
+
+    m_monitor = udev_monitor_new_from_netlink(m_udev, "udev");
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    bool ok = m_monitor && m_epollFd >= 0 && m_wakeFd >= 0;
+    // hidraw "add" tells us the node is ready to open; the parent hid device
+    // carries HID_ID on its "remove" event, after the hidraw node is gone.
+    ok = ok && udev_monitor_filter_add_match_subsystem_devtype(m_monitor, "hidraw", nullptr) >= 0;
+    ok = ok && udev_monitor_filter_add_match_subsystem_devtype(m_monitor, "hid", nullptr) >= 0;
+    ok = ok && udev_monitor_enable_receiving(m_monitor) >= 0;
+
+    if (ok) {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = udev_monitor_get_fd(m_monitor);
+        ok = epoll_ctl(m_epollFd, EPOLL_CTL_ADD, ev.data.fd, &ev) == 0;
+        ev.data.fd = m_wakeFd;
+        ok = ok && epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &ev) == 0;
+    }
+
+    if (!ok && m_monitor) {
+        udev_monitor_unref(m_monitor);
+        m_monitor = nullptr;
+    }
+}
+
+HotplugMonitor::~HotplugMonitor() {
+    if (m_monitor) udev_monitor_unref(m_monitor);
+    if (m_udev) udev_unref(m_udev);
+    if (m_wakeFd >= 0) close(m_wakeFd);
+    if (m_epollFd >= 0) close(m_epollFd);
+}
+
+bool HotplugMonitor::WaitForDevice(uint16_t vendorId, uint16_t productId, int timeoutMs) {
+    return WaitForDevices({{vendorId, productId}}, timeoutMs);
+}
+
+bool HotplugMonitor::WaitForDevices(const std::vector<std::pair<uint16_t, uint16_t>>& ids, int timeoutMs) {
+    if (!m_monitor) return false;
+
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+
+    while (true) {
+        int waitMs = timeoutMs;
+        if (timeoutMs >= 0) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+            waitMs = static_cast<int>(std::max<int64_t>(remaining.count(), 0));
+        }
+
+        epoll_event events[2];
+        int count = epoll_wait(m_epollFd, events, 2, waitMs);
+        if (count <= 0) return false;
+
+        bool matched = false;
+        for (int i = 0; i < count; ++i) {
+            if (events[i].data.fd == m_wakeFd) {
+                uint64_t value = 0;
+                [[maybe_unused]] ssize_t ignored = read(m_wakeFd, &value, sizeof(value));
+                return false;
+            }
+            matched = DrainEvents(ids) || matched;
+        }
+        if (matched) return true;
+    }
+}
+
+bool HotplugMonitor::DrainEvents(const std::vector<std::pair<uint16_t, uint16_t>>& ids) {
+    bool matched = false;
+    while (udev_device* dev = udev_monitor_receive_device(m_monitor)) {
+        const char* action = udev_device_get_action(dev);
+        if (action && std::strcmp(action, "add") == 0) {
+            if (udev_device* parent = udev_device_get_parent_with_subsystem_devtype(dev, "hid", nullptr)) {
+                // The parent is owned by the child; no unref
+                matched = MatchesHidId(udev_device_get_property_value(parent, "HID_ID"), ids) || matched;
+            }
+        } else if (action && std::strcmp(action, "remove") == 0) {
+            matched = MatchesHidId(udev_device_get_property_value(dev, "HID_ID"), ids) || matched;
+        }
+        udev_device_unref(dev);
+    }
+    return matched;
+}
+
+void HotplugMonitor::Wake() {
+    if (m_wakeFd < 0) return;
+    uint64_t one = 1;
+    [[maybe_unused]] ssize_t ignored = write(m_wakeFd, &one, sizeof(one));
+}
@@ -0,0 +1,70 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+struct udev;
+struct udev_monitor;
+
+/**
+ * @brief Watches the udev netlink socket for HID devices coming and going.
+ *
+ * Lets the HID worker sleep while the controller is unplugged instead of
+ * re-enumerating the HID bus on a timer.  If udev cannot be reached (no
+ * libudev daemon, restricted netlink access, ...) IsAvailable() returns false
+ * and callers should fall back to polling.
+ */
+class HotplugMonitor {
+public:
+    HotplugMonitor();
+    ~HotplugMonitor();
+
+    HotplugMonitor(const HotplugMonitor&) = delete;
+    HotplugMonitor& operator=(const HotplugMonitor&) = delete;
+
+    [[nodiscard]] bool IsAvailable() const { return m_monitor != nullptr; }
+
+    /**
+     * @brief Blocks until a device with the given IDs is added or removed,
+     * Wake() is called, or the timeout expires.  Events for other devices are
+     * consumed without returning.
+     * @param timeoutMs Maximum time to wait in milliseconds; -1 waits indefinitely.
+     * @return true if a matching device event was seen.
+     */
+    bool WaitForDevice(uint16_t vendorId, uint16_t productId, int timeoutMs);
+
+    /**
+     * @brief As WaitForDevice(), returning when a device with any of the
+     * given vendor/product ID pairs is added or removed.
+     */
+    bool WaitForDevices(const std::vector<std::pair<uint16_t, uint16_t>>& ids, int timeoutMs);
+
+    /**
+     * @brief Interrupts a pending WaitForDevice() from another thread.
+     */
+    void Wake();
+
+private:
+    bool DrainEvents(const std::vector<std::pair<uint16_t, uint16_t>>& ids);
+
+    udev* m_udev = nullptr;
+    udev_monitor* m_monitor = nullptr;
+    int m_epollFd = -1;
+    int m_wakeFd = -1;
+};
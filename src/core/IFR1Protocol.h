@@ -15,6 +15,7 @@
  */
 
 #pragma once
+#include <chrono>
 #include <cstdint>
 
 namespace IFR1 {
@@ -55,7 +56,13 @@ struct HardwareEvent {
     int8_t outerKnobRotation = 0;
     int8_t innerKnobRotation = 0;
     Mode mode = Mode::COM1;
-    bool buttonStates[12]{};
+    // Buttons held in this report.  In all three masks bit n is Button n.
+    uint16_t buttons = 0;
+    // Presses completed by this event, classified on the worker thread
+    uint16_t shortPresses = 0;
+    uint16_t longPresses = 0;
+    // When the report was read from the device
+    std::chrono::steady_clock::time_point timestamp{};
 };
 
 namespace LEDMask {
@@ -89,4 +96,6 @@ namespace BitPosition {
     constexpr uint8_t VS = 4;
 }
 
+constexpr uint8_t BUTTON_COUNT = 12;
+
 } // namespace IFR1
@@ -15,7 +15,10 @@
  */
 
 #pragma once
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <string>
 #include <vector>
 
 class IHardwareManager {
@@ -28,4 +31,53 @@ public:
 
     virtual int Read(uint8_t* data, size_t length, int timeoutMs) = 0;
     virtual int Write(const uint8_t* data, size_t length) = 0;
+
+    /**
+     * @brief Whether WaitForInput() can block on the device itself.
+     * Backends that return false are polled by the caller instead.
+     */
+    [[nodiscard]] virtual bool CanWaitForInput() const { return false; }
+
+    /**
+     * @brief Blocks until a report is readable, the device goes away, Wake() is
+     * called, or the timeout expires.  Only meaningful when CanWaitForInput().
+     * @param timeoutMs Maximum time to wait in milliseconds; -1 waits indefinitely.
+     */
+    virtual void WaitForInput(int /*timeoutMs*/) {}
+
+    /**
+     * @brief Whether WaitForDevice() can block until the device is plugged in.
+     * Backends that return false are reconnected by polling Connect().
+     */
+    [[nodiscard]] virtual bool SupportsHotplug() const { return false; }
+
+    /**
+     * @brief Blocks until a device matching the IDs of the last Connect() call
+     * appears or disappears, Shutdown() is called, or the timeout expires.  Only
+     * meaningful when SupportsHotplug().
+     * @param timeoutMs Maximum time to wait in milliseconds; -1 waits indefinitely.
+     */
+    virtual void WaitForDevice(int /*timeoutMs*/) {}
+
+    /**
+     * @brief Interrupts a pending WaitForInput() from another thread.
+     */
+    virtual void Wake() {}
+
+    /**
+     * @brief Interrupts a pending WaitForInput() or WaitForDevice() from
+     * another thread because the caller is shutting down.
+     */
+    virtual void Shutdown() { Wake(); }
 };
+
+/**
+ * @brief Creates the preferred hardware backend for this platform.
+ * @param serial If non-empty, Connect() only opens the unit with this serial number.
+ */
+std::unique_ptr<IHardwareManager> CreateHardwareManager(const std::string& serial = "");
+
+/**
+ * @brief Lists the serial numbers of all attached devices with the given IDs.
+ */
+std::vector<std::string> EnumerateHardwareSerials(uint16_t vendorId, uint16_t productId);
@@ -0,0 +1,119 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+/**
+ * @brief Lock-free single-producer/single-consumer mailbox holding only the
+ * newest value.
+ *
+ * Exactly one thread may call Publish() and exactly one (other) thread may
+ * call Take(), HasNew() and Discard().  No call blocks and no call allocates.
+ *
+ * Unlike SPSCRingBuffer nothing queues up: a value published before the
+ * consumer took the previous one replaces it, so the consumer only ever
+ * sees the latest state.  The values live in three slots (one being written,
+ * one being read, one in between) and a single atomic word holds the index of
+ * the slot in between together with a generation counter that Publish()
+ * advances, which is how Take() tells a fresh value from one it has already
+ * seen.
+ *
+ * @tparam T Value type.  Must be default-constructible and copyable.
+ */
+template <typename T>
+class LatestValueMailbox {
+public:
+    LatestValueMailbox() = default;
+    LatestValueMailbox(const LatestValueMailbox&) = delete;
+    LatestValueMailbox& operator=(const LatestValueMailbox&) = delete;
+
+    /**
+     * @brief Producer side.  Makes `value` the newest state.
+     */
+    void Publish(const T& value) {
+        m_slots[m_back] = value;
+        m_published = (m_published + 1) & kGenerationMask;
+        const uint32_t previous = m_state.exchange(Pack(m_back, m_published), std::memory_order_acq_rel);
+        m_back = SlotOf(previous);
+    }
+
+    /**
+     * @brief Consumer side.  Returns the newest state if it was published
+     * after the last Take().
+     */
+    std::optional<T> Take() {
+        uint32_t state = m_state.load(std::memory_order_acquire);
+        do {
+            if (GenerationOf(state) == m_taken) return std::nullopt;
+            // Trade the slot just read for the fresh one, keeping the
+            // generation so the value is not taken twice
+        } while (!m_state.compare_exchange_weak(state, Pack(m_front, GenerationOf(state)),
+                                                std::memory_order_acq_rel, std::memory_order_acquire));
+        m_front = SlotOf(state);
+        m_taken = GenerationOf(state);
+        return m_slots[m_front];
+    }
+
+    /**
+     * @brief Consumer side.  True if Take() would return a value.
+     */
+    [[nodiscard]] bool HasNew() const {
+        return GenerationOf(m_state.load(std::memory_order_acquire)) != m_taken;
+    }
+
+    /**
+     * @brief Consumer side.  Drops any value not yet taken.
+     */
+    void Discard() {
+        m_taken = GenerationOf(m_state.load(std::memory_order_acquire));
+    }
+
+    /**
+     * @brief Number of values published so far, modulo 2^30.  Safe from any thread.
+     */
+    [[nodiscard]] uint32_t GetGeneration() const {
+        return GenerationOf(m_state.load(std::memory_order_acquire));
+    }
+
+private:
+    static constexpr uint32_t kSlotBits = 2;
+    static constexpr uint32_t kGenerationMask = (1u << (32 - kSlotBits)) - 1;
+
+    static constexpr uint32_t Pack(uint32_t slot, uint32_t generation) { return (generation << kSlotBits) | slot; }
+    static constexpr uint32_t SlotOf(uint32_t state) { return state & ((1u << kSlotBits) - 1); }
+    static constexpr uint32_t GenerationOf(uint32_t state) { return state >> kSlotBits; }
+
+    // Fixed rather than std::hardware_destructive_interference_size; see SPSCRingBuffer
+    static constexpr size_t kCacheLine = 64;
+
+    // Slot in between plus the generation of the value in it
+    alignas(kCacheLine) std::atomic<uint32_t> m_state{Pack(1, 0)};
+
+    // Producer-owned: slot being written and the last generation published
+    alignas(kCacheLine) uint32_t m_back = 0;
+    uint32_t m_published = 0;
+
+    // Consumer-owned: slot last taken and its generation
+    alignas(kCacheLine) uint32_t m_front = 2;
+    uint32_t m_taken = 0;
+
+    std::array<T, 3> m_slots{};
+};
@@ -0,0 +1,74 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief Compact description of what the LEDs should show, independent of time.
+ *
+ * The flight loop evaluates the LED conditions into a program and only
+ * publishes it when it changes; the device worker renders it against its own
+ * monotonic clock, so blink edges land on time however slowly the sim runs.
+ * Bit n of each mask is LED report bit n.
+ */
+struct LedProgram {
+    static constexpr int kLedCount = 8;
+
+    uint8_t solid = 0;                          // LEDs lit steadily
+    uint8_t blinking = 0;                       // LEDs following their blink rate
+    std::array<float, kLedCount> blinkHz{};     // Full on/off cycles per second
+    std::array<float, kLedCount> blinkPhase{};  // Offset into the cycle, as a fraction of it
+
+    bool operator==(const LedProgram&) const = default;
+
+    /**
+     * @brief LED bits lit at `seconds`.  A blinking LED is lit for the first
+     * half of each cycle.
+     */
+    [[nodiscard]] uint8_t Render(double seconds) const {
+        uint8_t bits = solid;
+        for (uint8_t pending = blinking; pending != 0; pending &= pending - 1) {
+            const int i = std::countr_zero(pending);
+            const double cycles = seconds * blinkHz[i] + blinkPhase[i];
+            if (cycles - std::floor(cycles) < 0.5) {
+                bits |= static_cast<uint8_t>(1u << i);
+            }
+        }
+        return bits;
+    }
+
+    /**
+     * @brief Time after `seconds` at which Render() next changes, or infinity
+     * if nothing blinks.
+     */
+    [[nodiscard]] double NextEdge(double seconds) const {
+        double edge = std::numeric_limits<double>::infinity();
+        for (uint8_t pending = blinking; pending != 0; pending &= pending - 1) {
+            const int i = std::countr_zero(pending);
+            const double cycles = seconds * blinkHz[i] + blinkPhase[i];
+            const double nextHalf = (std::floor(cycles * 2.0) + 1.0) / 2.0;
+            edge = std::min(edge, (nextHalf - blinkPhase[i]) / blinkHz[i]);
+        }
+        return edge;
+    }
+};
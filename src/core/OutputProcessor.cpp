@@ -15,13 +15,18 @@
  */
 
 #include "OutputProcessor.h"
-#include "DataRefUtils.h"
 #include "IFR1Protocol.h"
 #include "Logger.h"
-#include <cmath>
+#include <bit>
 
 void OutputProcessor::ParseOutputConfig(const nlohmann::json& config) {
-    m_parsedLEDs.clear();
+    m_table.Clear();
+    m_outputMask.clear();
+    m_ruleMode.clear();
+    m_ruleBlinkHz.clear();
+    m_ruleBlinkPhase.clear();
+    m_arrayWindows.clear();
+    m_haveResult = false;
 
     if (config.empty() || !config.contains("output")) {
         return;
@@ -31,34 +36,30 @@ void OutputProcessor::ParseOutputConfig(const nlohmann::json& config) {
 
     auto parseLED = [&](const std::string& name, uint8_t mask) {
         if (output.contains(name) && output[name].contains("conditions")) {
-            ParsedLED ledDef;
-            ledDef.mask = mask;
+            const auto ledIndex = static_cast<uint32_t>(m_outputMask.size());
+            m_outputMask.push_back(mask);
 
             for (const auto& condition : output[name]["conditions"]) {
-                if (!condition.contains("dataref")) continue;
-
-                ParsedCondition parsed;
-                parsed.rawName = condition["dataref"];
-                
-                auto info = ::ParseDataRef(parsed.rawName);
-                parsed.drRef = m_sdk.FindDataRef(info.name.c_str());
-                parsed.index = info.index;
-
-                if (condition.contains("bit")) {
-                    parsed.bit = condition["bit"].get<int>();
-                } else if (condition.contains("min") && condition.contains("max")) {
-                    parsed.minVal = condition["min"].get<double>();
-                    parsed.maxVal = condition["max"].get<double>();
-                }
-                
-                parsed.mode = condition.value("mode", "solid");
-                if (parsed.mode == "blink") {
-                    parsed.blinkRate = condition.contains("blink-rate") ? static_cast<float>(condition["blink-rate"].get<double>()) : IFR1::DEFAULT_BLINK_RATE_HZ;
+                if (!condition.is_object()) continue;
+
+                LedMode mode = LedMode::Dark;
+                float blinkRate = 0.0f;
+                float blinkPhase = 0.0f;
+                const std::string modeName = condition.value("mode", "solid");
+                if (modeName == "solid") {
+                    mode = LedMode::Solid;
+                } else if (modeName == "blink") {
+                    blinkRate = condition.contains("blink-rate") ? static_cast<float>(condition["blink-rate"].get<double>()) : IFR1::DEFAULT_BLINK_RATE_HZ;
+                    blinkPhase = static_cast<float>(condition.value("blink-phase", 0.0));
+                    mode = blinkRate > 0 ? LedMode::Blink : LedMode::Dark;
                 }
 
-                ledDef.conditions.push_back(parsed);
+                // Payload columns line up with the table's rule indices
+                m_table.AddRule(ledIndex, m_evaluator.CompileCondition(condition));
+                m_ruleMode.push_back(mode);
+                m_ruleBlinkHz.push_back(blinkRate);
+                m_ruleBlinkPhase.push_back(blinkPhase);
             }
-            m_parsedLEDs.push_back(ledDef);
         }
     };
 
@@ -68,35 +69,67 @@ void OutputProcessor::ParseOutputConfig(const nlohmann::json& config) {
     parseLED("apr", IFR1::LEDMask::APR);
     parseLED("alt", IFR1::LEDMask::ALT);
     parseLED("vs", IFR1::LEDMask::VS);
+
+    ConditionEvaluator::GroupArrayReads(m_table.GetDependencies(), m_arrayWindows);
 }
 
-uint8_t OutputProcessor::EvaluateLEDs(float currentTime) const
+const LedProgram& OutputProcessor::EvaluateProgram()
 {
-    if (m_parsedLEDs.empty()) {
-        return IFR1::LEDMask::OFF;
+    if (m_outputMask.empty()) {
+        m_lastResult = LedProgram{};
+        return m_lastResult;
     }
 
-    uint8_t ledBits = IFR1::LEDMask::OFF;
-    bool verbose = false; // Hard-coded to false to avoid log spam from high-frequency LED updates
-
-    for (const auto& ledDef : m_parsedLEDs) {
-        for (const auto& condition : ledDef.conditions) {
-            if (m_evaluator.EvaluateParsedCondition(condition, verbose)) {
-                if (condition.mode == "solid") {
-                    ledBits |= ledDef.mask;
-                } else if (condition.mode == "blink") {
-                    if (condition.blinkRate > 0) {
-                        float period = 1.0f / condition.blinkRate;
-                        float phase = std::fmod(currentTime, period);
-                        if (phase < period / 2.0f) {
-                            ledBits |= ledDef.mask;
-                        }
-                    }
-                }
-                break; // Precedence: first condition met wins
-            }
+    // Outside the flight loop's frame this call is a frame of its own, so the
+    // snapshot and the conditions share one read of each dataref
+    const bool ownFrame = !m_dataRefs.InFrame();
+    if (ownFrame) m_dataRefs.BeginFrame();
+    m_evaluator.PrefetchArrays(m_arrayWindows);
+
+    const auto& dependencies = m_table.GetDependencies();
+    m_sample.resize(dependencies.size());
+    for (size_t i = 0; i < dependencies.size(); ++i) {
+        m_sample[i] = m_evaluator.SampleDependency(dependencies[i]);
+    }
+
+    if (!m_haveResult || m_sample != m_lastSample) {
+        m_lastResult = RunConditions();
+        m_lastSample.swap(m_sample);
+        m_haveResult = true;
+    }
+
+    if (ownFrame) m_dataRefs.EndFrame();
+    return m_lastResult;
+}
+
+LedProgram OutputProcessor::RunConditions()
+{
+    ++m_evaluations;
+
+    // Precedence: first condition met wins
+    m_table.Evaluate(m_sample, m_evaluator, m_firstMatch);
+
+    LedProgram program;
+    for (size_t led = 0; led < m_outputMask.size(); ++led) {
+        const int32_t rule = m_firstMatch[led];
+        if (rule == ConditionTable::kNoMatch) continue;
+
+        const uint8_t mask = m_outputMask[led];
+        switch (m_ruleMode[rule]) {
+        case LedMode::Solid:
+            program.solid |= mask;
+            break;
+        case LedMode::Blink: {
+            const int bit = std::countr_zero(mask);
+            program.blinking |= mask;
+            program.blinkHz[bit] = m_ruleBlinkHz[rule];
+            program.blinkPhase[bit] = m_ruleBlinkPhase[rule];
+            break;
+        }
+        case LedMode::Dark:
+            break;
         }
     }
 
-    return ledBits;
+    return program;
 }
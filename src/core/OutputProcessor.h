@@ -18,13 +18,21 @@
 #include "XPlaneSDK.h"
 #include <nlohmann/json.hpp>
 #include <vector>
-#include <map>
 #include "ConditionEvaluator.h"
-#include "ParsedCondition.h"
+#include "ConditionTable.h"
+#include "DataRefRegistry.h"
+#include "LedProgram.h"
+#include <memory>
 
 class OutputProcessor {
 public:
-    explicit OutputProcessor(IXPlaneSDK& sdk) : m_sdk(sdk), m_evaluator(sdk) {}
+    /** @brief Uses a private DataRefRegistry. */
+    explicit OutputProcessor(IXPlaneSDK& sdk)
+        : m_sdk(sdk), m_ownedDataRefs(std::make_unique<DataRefRegistry>(sdk)), m_dataRefs(*m_ownedDataRefs),
+          m_evaluator(sdk, m_dataRefs) {}
+
+    OutputProcessor(IXPlaneSDK& sdk, DataRefRegistry& dataRefs)
+        : m_sdk(sdk), m_dataRefs(dataRefs), m_evaluator(sdk, dataRefs) {}
 
     /**
      * @brief Parses the output configuration and resolves datarefs.
@@ -32,20 +40,55 @@ public:
      */
     void ParseOutputConfig(const nlohmann::json& config);
 
+    /**
+     * @brief Evaluates the LED conditions into a time-independent program.
+     * The conditions only run again when a dataref they read has changed;
+     * otherwise the previous program is returned after comparing a packed
+     * snapshot of those datarefs.
+     */
+    [[nodiscard]] const LedProgram& EvaluateProgram();
+
     /**
      * @brief Evaluates LED states based on parsed conditions.
      * @param currentTime Current time in seconds (for blinking).
      * @return 8-bit mask of LEDs to be lit.
      */
-    [[nodiscard]] uint8_t EvaluateLEDs(float currentTime) const;
+    [[nodiscard]] uint8_t EvaluateLEDs(float currentTime) { return EvaluateProgram().Render(currentTime); }
+
+    /** @brief Number of times EvaluateProgram() has had to run the conditions. */
+    [[nodiscard]] uint64_t GetEvaluationCount() const { return m_evaluations; }
 
 private:
     IXPlaneSDK& m_sdk;
+    std::unique_ptr<DataRefRegistry> m_ownedDataRefs;
+    DataRefRegistry& m_dataRefs;
     ConditionEvaluator m_evaluator;
 
-    struct ParsedLED {
-        uint8_t mask;
-        std::vector<ParsedCondition> conditions;
+    // What a matching LED condition does
+    enum class LedMode : uint8_t {
+        Solid,
+        Blink,
+        Dark        // Unknown mode or a blink rate of 0: matches, lights nothing
     };
-    std::vector<ParsedLED> m_parsedLEDs;
+
+    // One output per configured LED and one rule per condition.  Rule payloads
+    // are indexed by the rule index ConditionTable::AddRule() returns.
+    ConditionTable m_table;
+    std::vector<uint8_t> m_outputMask;
+    std::vector<LedMode> m_ruleMode;
+    std::vector<float> m_ruleBlinkHz;
+    std::vector<float> m_ruleBlinkPhase;
+    std::vector<int32_t> m_firstMatch;
+    // Array elements the table reads, grouped for one SDK call per window
+    std::vector<ArrayWindow> m_arrayWindows;
+
+    // Change detection.  m_lastSample holds the packed values of the table's
+    // dependencies when the conditions last ran.
+    std::vector<uint64_t> m_sample;
+    std::vector<uint64_t> m_lastSample;
+    bool m_haveResult = false;
+    LedProgram m_lastResult;
+    uint64_t m_evaluations = 0;
+
+    LedProgram RunConditions();
 };
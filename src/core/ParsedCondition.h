@@ -16,18 +16,72 @@
 
 #pragma once
 
+#include "DataRefRegistry.h"
+#include <cstdint>
 #include <string>
-#include <optional>
+#include <vector>
 
-struct ParsedCondition {
-    std::string rawName;
-    void* drRef = nullptr;
+/**
+ * @brief Operation performed by one ConditionNode.
+ */
+enum class ConditionOp : uint8_t {
+    Never,          // Malformed condition; never true
+    All,            // Every child is true (true if there are none)
+    Any,            // At least one child is true
+    Not,            // The single child is false
+    Range,          // minVal <= value <= maxVal
+    Bit,            // Bit `bit` of the integer value is set
+    Equal,          // value == operand
+    NotEqual,       // value != operand
+    Less,           // value < operand
+    Greater,        // value > operand
+    StringEquals    // A byte dataref holds `text`
+};
+
+/**
+ * @brief One node of a compiled condition tree.
+ */
+struct ConditionNode {
+    ConditionOp op = ConditionOp::Never;
+    uint32_t end = 0;               // Index one past this node's subtree; children of a group follow it
+    DataRefId dataRef = 0;
+    int index = -1;                 // Array element, or -1 for a scalar dataref
+    int bit = 0;
+    double operand = 0.0;           // Comparison value, or the range minimum
+    double maxVal = 0.0;
+    std::string text;               // StringEquals only
+    std::string rawName;            // Dataref as written in the config, for logging
+};
+
+/**
+ * @brief A condition compiled by ConditionEvaluator, stored flat in pre-order.
+ * nodes[0] is the root.  An empty tree has no conditions and is always true.
+ */
+struct ConditionTree {
+    std::vector<ConditionNode> nodes;
+
+    [[nodiscard]] bool empty() const { return nodes.empty(); }
+};
+
+/**
+ * @brief One dataref element read by a condition; see ConditionEvaluator::CollectDependencies().
+ */
+struct ConditionDependency {
+    DataRefId dataRef = 0;
     int index = -1;
+    bool text = false;              // Read as a string by StringEquals
 
-    std::optional<int> bit;
-    std::optional<double> minVal;
-    std::optional<double> maxVal;
+    bool operator==(const ConditionDependency&) const = default;
+};
+
+/**
+ * @brief Elements [first, first + count) of an array dataref, read together;
+ * see ConditionEvaluator::GroupArrayReads().
+ */
+struct ArrayWindow {
+    DataRefId dataRef = 0;
+    int first = 0;
+    int count = 0;
 
-    std::string mode = "solid";
-    float blinkRate = 2.0f; // IFR1::DEFAULT_BLINK_RATE_HZ
+    bool operator==(const ArrayWindow&) const = default;
 };
@@ -0,0 +1,126 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+/**
+ * @brief Bounded, lock-free single-producer/single-consumer ring buffer.
+ *
+ * Exactly one thread may call Push() and exactly one (other) thread may call
+ * Pop() and Clear().  No call blocks and no call allocates.
+ *
+ * Overflow policy: when the buffer is full Push() rejects the new element,
+ * returns false and increments DroppedCount().  Elements already queued are
+ * never overwritten, so the consumer always sees a gap-free prefix of what
+ * was produced.
+ *
+ * @tparam T        Element type.  Must be default-constructible and movable.
+ * @tparam Capacity Number of slots; must be a power of two.
+ */
+template <typename T, size_t Capacity>
+class SPSCRingBuffer {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    SPSCRingBuffer() = default;
+    SPSCRingBuffer(const SPSCRingBuffer&) = delete;
+    SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
+
+    /**
+     * @brief Producer side.  Appends a value if there is room.
+     * @return false if the buffer was full and the value was dropped.
+     */
+    bool Push(T value) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead == Capacity) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == Capacity) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        m_slots[tail & kMask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side.  Removes the oldest value, if any.
+     */
+    std::optional<T> Pop() {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail) {
+                return std::nullopt;
+            }
+        }
+        T value = std::move(m_slots[head & kMask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    /**
+     * @brief Consumer side.  Discards everything currently queued.
+     */
+    void Clear() {
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+        m_head.store(m_cachedTail, std::memory_order_release);
+    }
+
+    /**
+     * @brief Approximate when called concurrently with Push/Pop; exact otherwise.
+     */
+    [[nodiscard]] bool IsEmpty() const {
+        return Size() == 0;
+    }
+
+    [[nodiscard]] size_t Size() const {
+        const size_t head = m_head.load(std::memory_order_acquire);
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    [[nodiscard]] static constexpr size_t GetCapacity() { return Capacity; }
+
+    /**
+     * @brief Number of values rejected by Push() because the buffer was full.
+     */
+    [[nodiscard]] size_t DroppedCount() const {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t kMask = Capacity - 1;
+    // Fixed rather than std::hardware_destructive_interference_size, which
+    // varies with compiler flags and triggers -Winterference-size warnings.
+    static constexpr size_t kCacheLine = 64;
+
+    // Consumer-owned line: read index plus the consumer's cached copy of the tail
+    alignas(kCacheLine) std::atomic<size_t> m_head{0};
+    size_t m_cachedTail = 0;
+
+    // Producer-owned line: write index plus the producer's cached copy of the head
+    alignas(kCacheLine) std::atomic<size_t> m_tail{0};
+    size_t m_cachedHead = 0;
+
+    alignas(kCacheLine) std::atomic<size_t> m_dropped{0};
+    std::array<T, Capacity> m_slots{};
+};
@@ -0,0 +1,195 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "SoundBank.h"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+SoundBank::~SoundBank()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeCv.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+SoundId SoundBank::Load(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_ids.find(path);
+    if (it != m_ids.end()) return it->second;
+
+    const auto id = static_cast<SoundId>(m_entries.size());
+    m_entries.push_back(Entry{path});
+    m_ids.emplace(path, id);
+    Enqueue(id);
+    return id;
+}
+
+std::shared_ptr<const SoundClip> SoundBank::Acquire(SoundId id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (id < 0 || static_cast<size_t>(id) >= m_entries.size()) return nullptr;
+
+    Entry& entry = m_entries[id];
+    if (entry.clip) {
+        entry.lastUse = ++m_useClock;
+    } else if (!entry.failed) {
+        // Evicted, or still loading; Enqueue ignores a sound already queued
+        Enqueue(id);
+    }
+    return entry.clip;
+}
+
+bool SoundBank::HasFailed(SoundId id) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return id >= 0 && static_cast<size_t>(id) < m_entries.size() && m_entries[id].failed;
+}
+
+const std::string& SoundBank::GetPath(SoundId id) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.at(static_cast<size_t>(id)).path;
+}
+
+size_t SoundBank::GetResidentBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_residentBytes;
+}
+
+bool SoundBank::WaitForLoads(int timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_idleCv.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                             [this] { return m_queue.empty() && !m_loading; });
+}
+
+void SoundBank::Enqueue(SoundId id)
+{
+    Entry& entry = m_entries[id];
+    if (entry.queued) return;
+    entry.queued = true;
+    m_queue.push_back(id);
+    if (!m_thread.joinable()) {
+        m_thread = std::thread([this] { LoaderThread(); });
+    }
+    m_wakeCv.notify_one();
+}
+
+void SoundBank::EvictOverBudget(SoundId keep)
+{
+    while (m_residentBytes > m_budgetBytes) {
+        Entry* oldest = nullptr;
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            Entry& entry = m_entries[i];
+            if (!entry.clip || static_cast<SoundId>(i) == keep) continue;
+            if (!oldest || entry.lastUse < oldest->lastUse) oldest = &entry;
+        }
+        if (!oldest) return;
+        m_residentBytes -= oldest->clip->pcm.size();
+        oldest->clip.reset();
+    }
+}
+
+void SoundBank::LoaderThread()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_wakeCv.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+        if (m_stopping) return;
+
+        const SoundId id = m_queue.front();
+        m_queue.pop_front();
+        const std::string path = m_entries[id].path;
+        m_loading = true;
+
+        // The disk is read without the lock so Acquire() never waits on it
+        lock.unlock();
+        auto clip = std::make_shared<SoundClip>();
+        std::ifstream file(path, std::ios::binary);
+        const bool ok = file && ParseWav(file, *clip);
+        lock.lock();
+
+        Entry& entry = m_entries[id];
+        entry.queued = false;
+        // A clip bigger than the whole budget would only evict everything else
+        if (!ok || clip->pcm.size() > m_budgetBytes) {
+            entry.failed = true;
+        } else {
+            entry.clip = std::move(clip);
+            entry.lastUse = ++m_useClock;
+            m_residentBytes += entry.clip->pcm.size();
+            EvictOverBudget(id);
+        }
+        m_loading = false;
+        if (m_queue.empty()) m_idleCv.notify_all();
+    }
+}
+
+bool SoundBank::ParseWav(std::istream& in, SoundClip& clip)
+{
+    auto read4 = [&](char* out) { return in.read(out, 4).gcount() == 4; };
+    auto read2 = [&](uint16_t& out) { return in.read(reinterpret_cast<char*>(&out), 2).gcount() == 2; };
+    auto read4u = [&](uint32_t& out) { return in.read(reinterpret_cast<char*>(&out), 4).gcount() == 4; };
+
+    char id[4];
+    if (!read4(id) || std::memcmp(id, "RIFF", 4) != 0) return false;
+    uint32_t riffSize;
+    if (!read4u(riffSize)) return false;
+    if (!read4(id) || std::memcmp(id, "WAVE", 4) != 0) return false;
+
+    bool fmtFound = false;
+    bool dataFound = false;
+
+    while (read4(id)) {
+        uint32_t chunkSize;
+        if (!read4u(chunkSize)) break;
+
+        if (std::memcmp(id, "fmt ", 4) == 0) {
+            uint16_t formatTag;
+            if (!read2(formatTag) || formatTag != 1) return false; // Not PCM
+            uint16_t channels;
+            if (!read2(channels)) return false;
+            clip.channels = channels;
+            uint32_t frequency;
+            if (!read4u(frequency)) return false;
+            clip.frequency = static_cast<int>(frequency);
+            in.seekg(6, std::ios::cur); // Skip bytes/sec and block align
+            uint16_t bitsPerSample;
+            if (!read2(bitsPerSample) || bitsPerSample != 16) return false;
+            if (chunkSize > 16) in.seekg(chunkSize - 16, std::ios::cur);
+            fmtFound = true;
+        } else if (std::memcmp(id, "data", 4) == 0) {
+            if (chunkSize > kMaxWavBytes) return false;
+            clip.pcm.resize(chunkSize);
+            in.read(clip.pcm.data(), chunkSize);
+            if (static_cast<uint32_t>(in.gcount()) != chunkSize) return false;
+            dataFound = true;
+            break; // Found data, we can stop
+        } else {
+            in.seekg(chunkSize, std::ios::cur);
+        }
+    }
+
+    return fmtFound && dataFound;
+}
@@ -0,0 +1,120 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+#include "XPlaneSDK.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 16-bit PCM samples decoded from a .wav file.
+ */
+struct SoundClip {
+    std::vector<char> pcm;
+    int frequency = 0;
+    int channels = 0;
+};
+
+/**
+ * @brief Loads .wav files on a background thread into a byte-budgeted LRU cache.
+ *
+ * Load() hands out a stable SoundId for a path and queues the file for the
+ * loader thread, so the flight loop never waits for the disk.  Acquire()
+ * returns the decoded clip only if it is already in memory.  When the cache
+ * grows past its budget the least recently played clips are evicted; an
+ * evicted sound is queued for loading again the next time it is acquired.
+ *
+ * Clips are shared, so one being played stays valid after it is evicted for
+ * as long as the caller holds it.  All methods are thread-safe; the loader
+ * thread starts with the first Load().
+ */
+class SoundBank {
+public:
+    static constexpr size_t kDefaultBudgetBytes = 32u * 1024u * 1024u;
+    // Guard against malformed files with absurdly large chunk sizes
+    static constexpr uint32_t kMaxWavBytes = 10u * 1024u * 1024u;
+
+    explicit SoundBank(size_t budgetBytes = kDefaultBudgetBytes) : m_budgetBytes(budgetBytes) {}
+    ~SoundBank();
+
+    SoundBank(const SoundBank&) = delete;
+    SoundBank& operator=(const SoundBank&) = delete;
+
+    /**
+     * @brief Returns the ID for a file and queues it for loading if it is not in memory.
+     * Loading the same path again returns the same ID.
+     */
+    SoundId Load(const std::string& path);
+
+    /**
+     * @brief Returns the clip if it is in memory, or nullptr while it is
+     * loading, after it failed to load, or for an unknown ID.  Never reads the disk.
+     */
+    std::shared_ptr<const SoundClip> Acquire(SoundId id);
+
+    /** @brief True if the file could not be read or is not 16-bit PCM. */
+    [[nodiscard]] bool HasFailed(SoundId id) const;
+
+    [[nodiscard]] const std::string& GetPath(SoundId id) const;
+
+    /** @brief Bytes of PCM data held in the cache. */
+    [[nodiscard]] size_t GetResidentBytes() const;
+
+    /**
+     * @brief Blocks until the load queue is empty or the timeout expires.
+     * @return true if every queued load has finished.
+     */
+    bool WaitForLoads(int timeoutMs);
+
+    /** @brief Decodes a RIFF/WAVE stream of 16-bit PCM. */
+    static bool ParseWav(std::istream& in, SoundClip& clip);
+
+private:
+    struct Entry {
+        std::string path;
+        std::shared_ptr<const SoundClip> clip;
+        uint64_t lastUse = 0;
+        bool queued = false;
+        bool failed = false;
+    };
+
+    void Enqueue(SoundId id);   // m_mutex held
+    void EvictOverBudget(SoundId keep);   // m_mutex held
+    void LoaderThread();
+
+    const size_t m_budgetBytes;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeCv;
+    std::condition_variable m_idleCv;
+    // Entries are never removed, so an ID stays valid for the bank's lifetime
+    std::deque<Entry> m_entries;
+    std::unordered_map<std::string, SoundId> m_ids;
+    std::deque<SoundId> m_queue;
+    bool m_loading = false;
+    size_t m_residentBytes = 0;
+    uint64_t m_useClock = 0;
+    bool m_stopping = false;
+    std::thread m_thread;
+};
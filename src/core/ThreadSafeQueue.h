@@ -1,62 +0,0 @@
-/*
- *   Copyright 2026 Kyle D. Ross
- *
- *   Licensed under the Apache License, Version 2.0 (the "License");
- *   you may not use this file except in compliance with the License.
- *   You may obtain a copy of the License at
- *
- *       http://www.apache.org/licenses/LICENSE-2.0
- *
- *   Unless required by applicable law or agreed to in writing, software
- *   distributed under the License is distributed on an "AS IS" BASIS,
- *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- *   See the License for the specific language governing permissions and
- *   limitations under the License.
- */
-
-#pragma once
-#include <queue>
-#include <mutex>
-#include <optional>
-
-template <typename T>
-class ThreadSafeQueue {
-public:
-    ThreadSafeQueue() = default;
-
-    void Push(T value) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_queue.push(std::move(value));
-    }
-
-    std::optional<T> Pop() {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        if (m_queue.empty()) {
-            return std::nullopt;
-        }
-        T value = std::move(m_queue.front());
-        m_queue.pop();
-        return value;
-    }
-
-    bool IsEmpty() const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_queue.empty();
-    }
-
-    size_t Size() const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_queue.size();
-    }
-
-    void Clear() {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        while (!m_queue.empty()) {
-            m_queue.pop();
-        }
-    }
-
-private:
-    mutable std::mutex m_mutex;
-    std::queue<T> m_queue;
-};
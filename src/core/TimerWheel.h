@@ -0,0 +1,115 @@
+/*
+ *   Copyright 2026 Kyle D. Ross
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Hashed timer wheel for timers that fire on the flight loop.
+ *
+ * Time is cut into fixed ticks and each timer sits in the slot of the tick
+ * it is due on, so Advance() only visits the slots for the ticks that have
+ * passed since the previous call.  The cost is proportional to the number
+ * of armed timers, not to how many things could have one.  Timers due more
+ * than a full turn of the wheel ahead stay in their slot until their round
+ * comes up.
+ *
+ * Timers fire no earlier than requested and at most one tick late.  There is
+ * no cancel: the owner forgets the key and ignores it when it fires.
+ */
+class TimerWheel {
+public:
+    static constexpr size_t kSlotCount = 64;
+    static constexpr float kDefaultTickSeconds = 0.01f;
+
+    explicit TimerWheel(float tickSeconds = kDefaultTickSeconds) : m_tickSeconds(tickSeconds) {}
+
+    /**
+     * @brief Arms a timer that fires `delay` seconds after `now`.
+     * A key may be armed more than once; each arming fires separately.
+     */
+    void Schedule(uint32_t key, float now, float delay) {
+        if (m_size == 0) m_lastTick = FloorTick(now);
+        // Never due in a tick that has already been swept
+        const int64_t dueTick = std::max(m_lastTick + 1, CeilTick(now + delay));
+        m_slots[static_cast<size_t>(dueTick) % kSlotCount].push_back(Timer{key, dueTick});
+        ++m_size;
+    }
+
+    /**
+     * @brief Fires every timer due at or before `now`, in no particular order.
+     * The callback may arm new timers; they are not considered until the next call.
+     */
+    template <typename Callback>
+    void Advance(float now, Callback&& onExpired) {
+        const int64_t nowTick = FloorTick(now);
+        if (m_size == 0 || nowTick <= m_lastTick) {
+            if (m_size == 0) m_lastTick = nowTick;
+            return;
+        }
+
+        // After a long gap one full turn reaches every slot
+        const int64_t last = std::min(nowTick, m_lastTick + static_cast<int64_t>(kSlotCount));
+        m_expired.clear();
+        for (int64_t tick = m_lastTick + 1; tick <= last; ++tick) {
+            auto& slot = m_slots[static_cast<size_t>(tick) % kSlotCount];
+            for (size_t i = 0; i < slot.size();) {
+                if (slot[i].dueTick <= nowTick) {
+                    m_expired.push_back(slot[i].key);
+                    slot[i] = slot.back();
+                    slot.pop_back();
+                } else {
+                    ++i;
+                }
+            }
+        }
+        m_size -= m_expired.size();
+        m_lastTick = nowTick;
+
+        for (uint32_t key : m_expired) {
+            onExpired(key);
+        }
+    }
+
+    /** @brief Drops every armed timer. */
+    void Clear() {
+        for (auto& slot : m_slots) slot.clear();
+        m_size = 0;
+    }
+
+    [[nodiscard]] bool Empty() const { return m_size == 0; }
+    [[nodiscard]] size_t Size() const { return m_size; }
+
+private:
+    struct Timer {
+        uint32_t key;
+        int64_t dueTick;
+    };
+
+    int64_t FloorTick(float time) const { return static_cast<int64_t>(std::floor(time / m_tickSeconds)); }
+    int64_t CeilTick(float time) const { return static_cast<int64_t>(std::ceil(time / m_tickSeconds)); }
+
+    float m_tickSeconds;
+    std::array<std::vector<Timer>, kSlotCount> m_slots;
+    size_t m_size = 0;
+    int64_t m_lastTick = 0;     // Last tick swept by Advance()
+    std::vector<uint32_t> m_expired;
+};
@@ -28,6 +28,10 @@ enum class DataRefType {
     Data = 32
 };
 
+// Handle returned by IXPlaneSDK::LoadSound()
+using SoundId = int;
+constexpr SoundId kNoSound = -1;
+
 enum class LogLevel {
     Error = 0,
     Info = 1,
@@ -52,6 +56,9 @@ public:
     virtual void SetDataiArray(void* dataRef, int value, int index) = 0;
     virtual float GetDatafArray(void* dataRef, int index) = 0;
     virtual void SetDatafArray(void* dataRef, float value, int index) = 0;
+    // Read `count` elements starting at `offset` in one call; return the number read
+    virtual int GetDataiArrayRange(void* dataRef, int* outValues, int offset, int count) = 0;
+    virtual int GetDatafArrayRange(void* dataRef, float* outValues, int offset, int count) = 0;
     virtual int GetDatab(void* dataRef, void* outData, int offset, int maxLength) = 0;
 
     // Commands
@@ -69,7 +76,11 @@ public:
     virtual bool FileExists(const std::string& path) = 0;
 
     // Sound
-    virtual void PlaySound(const std::string& path) = 0;
+    // LoadSound() queues the .wav file for a background load and returns its
+    // handle; PlaySound() only plays sounds already in memory, so neither
+    // reads the disk on the calling thread.
+    virtual SoundId LoadSound(const std::string& path) = 0;
+    virtual void PlaySound(SoundId sound) = 0;
 
     // Drawing
     virtual void DrawString(const float color[4], int x, int y, const char* string) = 0;
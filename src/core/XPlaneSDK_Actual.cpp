@@ -15,6 +15,7 @@
  */
 
 #include "XPlaneSDK.h"
+#include "SoundBank.h"
 #include "XPLMDataAccess.h"
 #include "XPLMUtilities.h"
 #include "XPLMProcessing.h"
@@ -24,19 +25,10 @@
 #include <GL/gl.h>
 #include <memory>
 #include <string>
-#include <fstream>
-#include <vector>
-#include <unordered_map>
 #include <cstring>
 #include <filesystem>
 #include <format>
 
-struct SoundBuffer {
-    std::vector<char> data;
-    int frequency{};
-    int channels{};
-};
-
 class XPlaneSDK : public IXPlaneSDK {
 public:
     void* FindDataRef(const char* name) override {
@@ -83,6 +75,14 @@ public:
         XPLMSetDatavf(static_cast<XPLMDataRef>(dataRef), &value, index, 1);
     }
 
+    int GetDataiArrayRange(void* dataRef, int* outValues, int offset, int count) override {
+        return XPLMGetDatavi(static_cast<XPLMDataRef>(dataRef), outValues, offset, count);
+    }
+
+    int GetDatafArrayRange(void* dataRef, float* outValues, int offset, int count) override {
+        return XPLMGetDatavf(static_cast<XPLMDataRef>(dataRef), outValues, offset, count);
+    }
+
     int GetDatab(void* dataRef, void* outData, int offset, int maxLength) override {
         return XPLMGetDatab(static_cast<XPLMDataRef>(dataRef), outData, offset, maxLength);
     }
@@ -144,30 +144,35 @@ public:
         return std::filesystem::exists(path);
     }
 
-    void PlaySound(const std::string& path) override {
-        auto it = m_sounds.find(path);
-        if (it == m_sounds.end()) {
-            SoundBuffer buffer;
-            if (LoadWav(path, buffer)) {
-                it = m_sounds.emplace(path, std::move(buffer)).first;
-            } else {
-                Log(LogLevel::Error, std::format("Failed to load sound: {}", path).c_str());
-                return;
+    SoundId LoadSound(const std::string& path) override {
+        return m_sounds.Load(path);
+    }
+
+    void PlaySound(SoundId sound) override {
+        auto clip = m_sounds.Acquire(sound);
+        if (!clip) {
+            // Still loading or evicted; the bank has queued it, so a later press plays
+            if (m_sounds.HasFailed(sound)) {
+                Log(LogLevel::Error, std::format("Failed to load sound: {}", m_sounds.GetPath(sound)).c_str());
             }
+            return;
         }
 
-        const auto& buf = it->second;
-        XPLMPlayPCMOnBus(
-            const_cast<char*>(buf.data.data()),
-            static_cast<uint32_t>(buf.data.size()),
+        // The channel keeps its own reference, so eviction cannot free the
+        // samples while FMOD is still playing them
+        auto* playing = new std::shared_ptr<const SoundClip>(std::move(clip));
+        FMOD_CHANNEL* channel = XPLMPlayPCMOnBus(
+            const_cast<char*>((*playing)->pcm.data()),
+            static_cast<uint32_t>((*playing)->pcm.size()),
             FMOD_SOUND_FORMAT_PCM16,
-            buf.frequency,
-            buf.channels,
+            (*playing)->frequency,
+            (*playing)->channels,
             0, // loop
             xplm_AudioUI,
-            nullptr, // callback
-            nullptr  // refcon
+            &OnSoundComplete,
+            playing
         );
+        if (!channel) delete playing;
     }
 
     void DrawString(const float color[4], int x, int y, const char* string) override {
@@ -265,58 +270,10 @@ public:
 
 private:
     LogLevel m_logLevel = LogLevel::Info;
-    std::unordered_map<std::string, SoundBuffer> m_sounds;
-
-    static bool LoadWav(const std::string& path, SoundBuffer& buffer) {
-        std::ifstream file(path, std::ios::binary);
-        if (!file) return false;
-
-        auto read4 = [&](char* out) { return file.read(out, 4).gcount() == 4; };
-        auto read2 = [&](uint16_t& out) { return file.read(reinterpret_cast<char*>(&out), 2).gcount() == 2; };
-        auto read4u = [&](uint32_t& out) { return file.read(reinterpret_cast<char*>(&out), 4).gcount() == 4; };
-
-        char id[4];
-        if (!read4(id) || std::memcmp(id, "RIFF", 4) != 0) return false;
-        uint32_t riffSize;
-        if (!read4u(riffSize)) return false;
-        if (!read4(id) || std::memcmp(id, "WAVE", 4) != 0) return false;
-
-        bool fmtFound = false;
-        bool dataFound = false;
-
-        while (read4(id)) {
-            uint32_t chunkSize;
-            if (!read4u(chunkSize)) break;
-
-            if (std::memcmp(id, "fmt ", 4) == 0) {
-                uint16_t formatTag;
-                if (!read2(formatTag) || formatTag != 1) return false; // Not PCM
-                uint16_t channels;
-                if (!read2(channels)) return false;
-                buffer.channels = channels;
-                uint32_t frequency;
-                if (!read4u(frequency)) return false;
-                buffer.frequency = static_cast<int>(frequency);
-                file.seekg(6, std::ios::cur); // Skip bytes/sec and block align
-                uint16_t bitsPerSample;
-                if (!read2(bitsPerSample) || bitsPerSample != 16) return false;
-                if (chunkSize > 16) file.seekg(chunkSize - 16, std::ios::cur);
-                fmtFound = true;
-            } else if (std::memcmp(id, "data", 4) == 0) {
-                // Guard against malformed files with absurdly large chunk sizes
-                constexpr uint32_t kMaxWavBytes = 10u * 1024u * 1024u; // 10 MB
-                if (chunkSize > kMaxWavBytes) return false;
-                buffer.data.resize(chunkSize);
-                file.read(buffer.data.data(), chunkSize);
-                if (static_cast<uint32_t>(file.gcount()) != chunkSize) return false;
-                dataFound = true;
-                break; // Found data, we can stop
-            } else {
-                file.seekg(chunkSize, std::ios::cur);
-            }
-        }
+    SoundBank m_sounds;
 
-        return fmtFound && dataFound;
+    static void OnSoundComplete(void* refcon, FMOD_RESULT) {
+        delete static_cast<std::shared_ptr<const SoundClip>*>(refcon);
     }
 };
 
@@ -26,10 +26,13 @@
 #include "XPLMMenus.h"
 
 #include "ConfigManager.h"
+#include "DataRefRegistry.h"
 #include "EventProcessor.h"
 #include "OutputProcessor.h"
-#include "HIDManager.h"
+#include "IHardwareManager.h"
+#include "DeviceProfile.h"
 #include "DeviceHandler.h"
+#include "DeviceWatcher.h"
 #include "XPlaneSDK.h"
 #include "core/SettingsManager.h"
 #include "ui/AboutWindow.h"
@@ -39,14 +42,28 @@
 
 namespace fs = std::filesystem;
 
+// Everything needed to drive one physical IFR-1.  Each unit gets its own
+// worker thread and queues, so units never contend with each other.
+struct DeviceContext {
+    std::string serial;
+    std::unique_ptr<IHardwareManager> hardware;
+    std::unique_ptr<EventProcessor> eventProcessor;
+    std::unique_ptr<OutputProcessor> outputProcessor;
+    std::unique_ptr<DeviceHandler> handler;
+    nlohmann::json config;
+};
+
 // Global state
 static std::unique_ptr<IXPlaneSDK> gSDK;
 static std::unique_ptr<ConfigManager> gConfigManager;
-static std::unique_ptr<EventProcessor> gEventProcessor;
-static std::unique_ptr<OutputProcessor> gOutputProcessor;
-static std::unique_ptr<HIDManager> gHIDManager;
 static std::unique_ptr<SettingsManager> gSettingsManager;
-static std::unique_ptr<DeviceHandler> gDeviceHandler;
+// Dataref handles shared by every device's event and output processors
+static std::unique_ptr<DataRefRegistry> gDataRefs;
+static std::vector<std::unique_ptr<DeviceContext>> gDevices;
+// Reports units as they are plugged in; see CreateNewDevices()
+static std::unique_ptr<DeviceWatcher> gDeviceWatcher;
+// Additional controller layouts loaded from the "profiles" directory
+static std::vector<DeviceProfile> gDeviceProfiles;
 
 static nlohmann::json gCurrentConfig;
 static std::string gCurrentAircraftPath;
@@ -54,6 +71,71 @@ static void* gAcfPathRef = nullptr;
 
 static XPLMFlightLoopID gFlightLoop = nullptr;
 
+static void ApplyConfigToDevice(DeviceContext& device, const nlohmann::json& config) {
+    device.handler->ClearLEDs();
+    device.config = ConfigManager::ResolveDeviceConfig(config, device.serial);
+    device.handler->ParseModeDescriptions(device.config);
+    device.outputProcessor->ParseOutputConfig(device.config);
+    device.eventProcessor->PrepareConfig(device.config);
+}
+
+static void ApplyConfigToDevices(const nlohmann::json& config) {
+    for (auto& device : gDevices) {
+        ApplyConfigToDevice(*device, config);
+    }
+}
+
+// Watcher target 0 is the IFR-1; the loaded profiles follow in order
+static const DeviceProfile& ProfileForTarget(size_t target) {
+    return target == 0 ? DeviceProfile::IFR1() : gDeviceProfiles[target - 1];
+}
+
+// Opens a context for every unit the watcher has found since the last call.
+// Each context is bound to its unit's serial number, so per-unit config
+// overrides always apply and a unit plugged in later gets its own context.
+static void CreateNewDevices() {
+    while (auto found = gDeviceWatcher->TakeNewDevice()) {
+        const DeviceProfile& profile = ProfileForTarget(found->target);
+        auto device = std::make_unique<DeviceContext>();
+        device->serial = std::move(found->serial);
+        device->hardware = CreateHardwareManager(device->serial);
+        device->eventProcessor = std::make_unique<EventProcessor>(*gSDK, *gDataRefs);
+        device->outputProcessor = std::make_unique<OutputProcessor>(*gSDK, *gDataRefs);
+        device->handler = std::make_unique<DeviceHandler>(*device->hardware, *device->eventProcessor,
+                                                          *device->outputProcessor, *gSettingsManager, *gSDK,
+                                                          true, profile);
+        if (device->serial.empty()) {
+            IFR1_LOG_INFO(*gSDK, "Driving {} (no serial number)", profile.GetName());
+        } else {
+            IFR1_LOG_INFO(*gSDK, "Driving {} with serial {}", profile.GetName(), device->serial);
+        }
+        ApplyConfigToDevice(*device, gCurrentConfig);
+        gDevices.push_back(std::move(device));
+    }
+}
+
+static void CreateDevices() {
+    std::vector<std::pair<uint16_t, uint16_t>> ids{{DeviceProfile::IFR1().GetVendorId(), DeviceProfile::IFR1().GetProductId()}};
+    for (const auto& profile : gDeviceProfiles) {
+        ids.emplace_back(profile.GetVendorId(), profile.GetProductId());
+    }
+    // The watcher enumerates once before returning, so attached units get
+    // their contexts right away
+    gDeviceWatcher = std::make_unique<DeviceWatcher>(std::move(ids), EnumerateHardwareSerials);
+    CreateNewDevices();
+}
+
+static void DestroyDevices() {
+    gDeviceWatcher.reset();
+    for (auto& device : gDevices) {
+        // Handler first: its worker thread uses the hardware manager
+        device->handler->ClearLEDs();
+        device->handler.reset();
+        device->hardware.reset();
+    }
+    gDevices.clear();
+}
+
 // Menu and UI
 static XPLMMenuID gSubMenu = nullptr;
 static int gSubMenuIndex = -1;
@@ -72,11 +154,13 @@ static void MenuHandler(void* /*inMenuRef*/, void* inItemRef) {
 
 // ReSharper disable once CppDFAConstantFunctionResult
 static float FlightLoopCallback(float /*inElapsedSinceLastCall*/, float /*inElapsedTimeSinceLastFlightLoop*/, int inCounter, void* /*inRefcon*/) {
-    if (!gSDK || !gDeviceHandler) return -1.0f;
+    if (!gSDK || !gDeviceWatcher) return -1.0f;
 
     try {
         float now = gSDK->GetElapsedTime();
 
+        CreateNewDevices();
+
         // 1. Aircraft detection every 20 frames (or if first time)
         static int lastDetectionCounter = -1;
         if (lastDetectionCounter == -1 || inCounter >= lastDetectionCounter + 20 || inCounter < lastDetectionCounter) {
@@ -95,7 +179,6 @@ static float FlightLoopCallback(float /*inElapsedSinceLastCall*/, float /*inElap
                     if (currentPath != gCurrentAircraftPath) {
                         IFR1_LOG_INFO(*gSDK, "Aircraft changed to {}", currentPath);
                         gCurrentAircraftPath = currentPath;
-                        gDeviceHandler->ClearLEDs();
                         gCurrentConfig = gConfigManager->GetConfigForAircraft(currentPath, *gSDK);
 
                         if (!gCurrentConfig.empty() && !gCurrentConfig.contains("output")) {
@@ -103,9 +186,7 @@ static float FlightLoopCallback(float /*inElapsedSinceLastCall*/, float /*inElap
                                            gCurrentConfig.value("name", "unknown"));
                         }
 
-                        gDeviceHandler->ParseModeDescriptions(gCurrentConfig);
-                        gOutputProcessor->ParseOutputConfig(gCurrentConfig);
-                        gEventProcessor->PrepareConfig(gCurrentConfig);
+                        ApplyConfigToDevices(gCurrentConfig);
 
                         // Update log level based on config
                         if (gCurrentConfig.value("debug", false)) {
@@ -130,8 +211,7 @@ static float FlightLoopCallback(float /*inElapsedSinceLastCall*/, float /*inElap
                         IFR1_LOG_INFO(*gSDK, "No aircraft detected.");
                         gCurrentAircraftPath.clear();
                         gCurrentConfig = nlohmann::json();
-                        gEventProcessor->PrepareConfig(gCurrentConfig);
-                        gDeviceHandler->ClearLEDs();
+                        ApplyConfigToDevices(gCurrentConfig);
                     }
                 }
             } else {
@@ -143,11 +223,16 @@ static float FlightLoopCallback(float /*inElapsedSinceLastCall*/, float /*inElap
             return -1.0f;
         }
 
-        // 2. Update hardware input
-        gDeviceHandler->Update(gCurrentConfig, now);
+        // Each dataref is read from X-Plane at most once per frame, across all devices
+        gDataRefs->BeginFrame();
+        for (auto& device : gDevices) {
+            // 2. Update hardware input
+            device->handler->Update(device->config, now);
 
-        // 3. Update LEDs
-        gDeviceHandler->UpdateLEDs(now);
+            // 3. Update LEDs
+            device->handler->UpdateLEDs();
+        }
+        gDataRefs->EndFrame();
 
     } catch (const std::exception& e) {
         IFR1_LOG_ERROR(*gSDK, "Unhandled exception in flight loop: {}", e.what());
@@ -164,6 +249,10 @@ PLUGIN_API int XPluginStart(char * outName, char * outSig, char * outDesc) {
     std::strcpy(outDesc, "Flexible IFR-1 interface.");
 
     gSDK = CreateXPlaneSDK();
+    gDataRefs = std::make_unique<DataRefRegistry>(*gSDK);
+
+    // Ask for XPLM_MSG_DATAREFS_ADDED so late-published datarefs are picked up promptly
+    XPLMEnableFeature("XPLM_WANTS_DATAREF_NOTIFICATIONS", 1);
 
     char pluginPath[512];
     XPLMGetPluginInfo(XPLMGetMyID(), nullptr, pluginPath, nullptr, nullptr);
@@ -173,10 +262,6 @@ PLUGIN_API int XPluginStart(char * outName, char * outSig, char * outDesc) {
     gSettingsManager->Load(*gSDK);
 
     gConfigManager = std::make_unique<ConfigManager>();
-    gEventProcessor = std::make_unique<EventProcessor>(*gSDK);
-    gOutputProcessor = std::make_unique<OutputProcessor>(*gSDK);
-    gHIDManager = std::make_unique<HIDManager>();
-    gDeviceHandler = std::make_unique<DeviceHandler>(*gHIDManager, *gEventProcessor, *gOutputProcessor, *gSettingsManager, *gSDK);
 
     // Config directory discovery:
     // 1. Check parent folder of the plugin binary (e.g. plugins/ifr1flex/64/lin.xpl -> plugins/ifr1flex/configs)
@@ -212,6 +297,12 @@ PLUGIN_API int XPluginStart(char * outName, char * outSig, char * outDesc) {
         IFR1_LOG_INFO(*gSDK, "{}", msg);
     }
 
+    // Device profiles for controllers other than the IFR-1 live next to the configs
+    if (!configDir.empty()) {
+        gDeviceProfiles = DeviceProfile::LoadProfiles((configDir.parent_path() / "profiles").string(), *gSDK);
+    }
+    CreateDevices();
+
     // Create Plugins menu: "IFR-1" -> "About..."
     if (XPLMMenuID pluginsMenu = XPLMFindPluginsMenu()) {
         gSubMenuIndex = XPLMAppendMenuItem(pluginsMenu, "IFR-1 Controller", nullptr, 0);
@@ -228,8 +319,7 @@ PLUGIN_API int XPluginStart(char * outName, char * outSig, char * outDesc) {
 }
 
 PLUGIN_API void XPluginStop(void) {
-    gDeviceHandler.reset();
-    gHIDManager.reset();
+    DestroyDevices();
     if (gFlightLoop) {
         XPLMDestroyFlightLoop(gFlightLoop);
         gFlightLoop = nullptr;
@@ -245,20 +335,14 @@ PLUGIN_API void XPluginStop(void) {
         gSubMenuIndex = -1;
     }
 
-    gOutputProcessor.reset();
-    gEventProcessor.reset();
     gConfigManager.reset();
+    gDeviceProfiles.clear();
+    gDataRefs.reset();
     gSDK.reset();
 }
 
 PLUGIN_API void XPluginDisable(void) {
-    if (gDeviceHandler) {
-        gDeviceHandler->ClearLEDs();
-        gDeviceHandler.reset();
-    }
-    if (gHIDManager) {
-        gHIDManager.reset();
-    }
+    DestroyDevices();
 
     if (gFlightLoop) {
         XPLMDestroyFlightLoop(gFlightLoop);
@@ -272,18 +356,17 @@ PLUGIN_API void XPluginDisable(void) {
 }
 
 PLUGIN_API int XPluginEnable(void) {
-    if (!gHIDManager) {
-        gHIDManager = std::make_unique<HIDManager>();
-    }
-    if (!gDeviceHandler) {
-        gDeviceHandler = std::make_unique<DeviceHandler>(*gHIDManager, *gEventProcessor, *gOutputProcessor, *gSettingsManager, *gSDK);
+    // Re-enumerate so units attached while disabled are picked up
+    if (!gDeviceWatcher) {
+        CreateDevices();
     }
 
     gCurrentAircraftPath.clear();
     gAcfPathRef = nullptr; // Force fresh dataref lookup on re-enable
+    gDataRefs->RetryMissing();
 
-    if (gDeviceHandler) {
-        gDeviceHandler->ClearLEDs();
+    for (auto& device : gDevices) {
+        device->handler->ClearLEDs();
     }
 
     XPLMCreateFlightLoop_t params;
@@ -299,4 +382,15 @@ PLUGIN_API int XPluginEnable(void) {
 }
 
 PLUGIN_API void XPluginReceiveMessage(XPLMPluginID inFromWho, int inMessage, void *inParam) {
+    if (!gDataRefs) return;
+    // Aircraft plugins publish their datarefs as the aircraft loads, so give
+    // everything that was missing another try on the next lookup
+    if (inMessage == XPLM_MSG_PLANE_LOADED) {
+        gDataRefs->RetryMissing();
+    }
+#if defined(XPLM400)
+    if (inMessage == XPLM_MSG_DATAREFS_ADDED) {
+        gDataRefs->RetryMissing();
+    }
+#endif
 }
\ No newline at end of file
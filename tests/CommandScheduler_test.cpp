@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "CommandScheduler.h"
+#include "XPlaneSDK.h"
+
+namespace {
+
+class MockXPlaneSDK : public IXPlaneSDK {
+public:
+    MockXPlaneSDK() {
+        ON_CALL(*this, Log(::testing::_, ::testing::_)).WillByDefault(::testing::Return());
+        ON_CALL(*this, GetLogLevel()).WillByDefault(::testing::Return(LogLevel::Info));
+        ON_CALL(*this, FileExists(::testing::_)).WillByDefault(::testing::Return(true));
+    }
+
+    MOCK_METHOD(void*, FindDataRef, (const char* name), (override));
+    MOCK_METHOD(int, GetDataRefTypes, (void* dataRef), (override));
+    MOCK_METHOD(int, GetDatai, (void* dataRef), (override));
+    MOCK_METHOD(void, SetDatai, (void* dataRef, int value), (override));
+    MOCK_METHOD(float, GetDataf, (void* dataRef), (override));
+    MOCK_METHOD(void, SetDataf, (void* dataRef, float value), (override));
+    MOCK_METHOD(int, GetDataiArray, (void* dataRef, int index), (override));
+    MOCK_METHOD(void, SetDataiArray, (void* dataRef, int value, int index), (override));
+    MOCK_METHOD(float, GetDatafArray, (void* dataRef, int index), (override));
+    MOCK_METHOD(int, GetDataiArrayRange, (void* dataRef, int* outValues, int offset, int count), (override));
+    MOCK_METHOD(int, GetDatafArrayRange, (void* dataRef, float* outValues, int offset, int count), (override));
+    MOCK_METHOD(void, SetDatafArray, (void* dataRef, float value, int index), (override));
+    MOCK_METHOD(int, GetDatab, (void* dataRef, void* outData, int offset, int maxLength), (override));
+    MOCK_METHOD(void*, FindCommand, (const char* name), (override));
+    MOCK_METHOD(void, CommandOnce, (void* commandRef), (override));
+    MOCK_METHOD(void, CommandBegin, (void* commandRef), (override));
+    MOCK_METHOD(void, CommandEnd, (void* commandRef), (override));
+    MOCK_METHOD(void, Log, (LogLevel level, const char* string), (override));
+    MOCK_METHOD(void, SetLogLevel, (LogLevel level), (override));
+    MOCK_METHOD(LogLevel, GetLogLevel, (), (const, override));
+    MOCK_METHOD(float, GetElapsedTime, (), (override));
+    MOCK_METHOD(std::string, GetSystemPath, (), (override));
+    MOCK_METHOD(bool, FileExists, (const std::string& path), (override));
+    MOCK_METHOD(SoundId, LoadSound, (const std::string& path), (override));
+    MOCK_METHOD(void, PlaySound, (SoundId sound), (override));
+    MOCK_METHOD(void, DrawString, (const float color[4], int x, int y, const char* string), (override));
+    MOCK_METHOD(void, DrawRectangle, (const float color[4], int l, int t, int r, int b), (override));
+    MOCK_METHOD(void, DrawRectangleOutline, (const float color[4], int l, int t, int r, int b), (override));
+    MOCK_METHOD(int, MeasureString, (const char* string), (override));
+    MOCK_METHOD(int, GetFontHeight, (), (override));
+    MOCK_METHOD(void, GetScreenSize, (int* outWidth, int* outHeight), (override));
+    MOCK_METHOD(void*, CreateWindowEx, (const WindowCreateParams& params), (override));
+    MOCK_METHOD(void, DestroyWindow, (void* windowId), (override));
+    MOCK_METHOD(void, SetWindowVisible, (void* windowId, int visible), (override));
+    MOCK_METHOD(void, SetWindowGeometry, (void* windowId, int left, int top, int right, int bottom), (override));
+    MOCK_METHOD(void, GetWindowGeometry, (void* windowId, int* outLeft, int* outTop, int* outRight, int* outBottom), (override));
+    MOCK_METHOD(void, GetScreenBoundsGlobal, (int* outLeft, int* outTop, int* outRight, int* outBottom), (override));
+};
+
+void* const kCmdA = reinterpret_cast<void*>(0xA);
+void* const kCmdB = reinterpret_cast<void*>(0xB);
+
+} // namespace
+
+TEST(CommandSchedulerTest, RunFrame_RunsUpToBudgetAndCarriesOverTheRest) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    CommandScheduler scheduler(mockSdk);
+    scheduler.SetBudget(4, 1000.0f);
+
+    EXPECT_EQ(scheduler.Enqueue(kCmdA, 10, CommandPriority::Normal, false), 10);
+    EXPECT_EQ(scheduler.GetStats().queueDepth, 10u);
+
+    EXPECT_CALL(mockSdk, CommandOnce(kCmdA)).Times(4);
+    scheduler.RunFrame();
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+    EXPECT_EQ(scheduler.GetStats().queueDepth, 6u);
+
+    EXPECT_CALL(mockSdk, CommandOnce(kCmdA)).Times(6);
+    scheduler.RunFrame();
+    scheduler.RunFrame();
+    EXPECT_EQ(scheduler.GetStats().executed, 10u);
+}
+
+TEST(CommandSchedulerTest, RunFrame_ExpiredTimeSliceStillRunsOneCommand) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    CommandScheduler scheduler(mockSdk);
+    scheduler.SetBudget(8, 0.0f);
+    scheduler.Enqueue(kCmdA, 3, CommandPriority::Normal, false);
+
+    EXPECT_CALL(mockSdk, CommandOnce(kCmdA)).Times(1);
+    scheduler.RunFrame();
+}
+
+TEST(CommandSchedulerTest, Enqueue_HighPriorityRunsFirst) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    CommandScheduler scheduler(mockSdk);
+    scheduler.SetBudget(8, 1000.0f);
+    scheduler.Enqueue(kCmdA, 2, CommandPriority::Normal, false);
+    scheduler.Enqueue(kCmdB, 1, CommandPriority::High, false);
+
+    ::testing::InSequence seq;
+    EXPECT_CALL(mockSdk, CommandOnce(kCmdB));
+    EXPECT_CALL(mockSdk, CommandOnce(kCmdA)).Times(2);
+    scheduler.RunFrame();
+}
+
+TEST(CommandSchedulerTest, Enqueue_MergesOnlyWhenAllowed) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    CommandScheduler scheduler(mockSdk);
+    scheduler.SetBudget(8, 1000.0f);
+
+    scheduler.Enqueue(kCmdA, 1, CommandPriority::High, true);
+    EXPECT_EQ(scheduler.Enqueue(kCmdA, 1, CommandPriority::High, true), 0);
+    // Without "merge" a repeated command still runs every time
+    scheduler.Enqueue(kCmdB, 1, CommandPriority::High, false);
+    scheduler.Enqueue(kCmdB, 1, CommandPriority::High, false);
+
+    auto stats = scheduler.GetStats();
+    EXPECT_EQ(stats.queueDepth, 3u);
+    EXPECT_EQ(stats.merged, 1u);
+
+    EXPECT_CALL(mockSdk, CommandOnce(kCmdA)).Times(1);
+    EXPECT_CALL(mockSdk, CommandOnce(kCmdB)).Times(2);
+    scheduler.RunFrame();
+}
+
+TEST(CommandSchedulerTest, Enqueue_MergesPastOtherPendingCommands) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    CommandScheduler scheduler(mockSdk);
+    scheduler.SetBudget(8, 1000.0f);
+
+    // An unrelated command queued in between must not defeat the merge
+    scheduler.Enqueue(kCmdA, 1, CommandPriority::High, true);
+    scheduler.Enqueue(kCmdB, 1, CommandPriority::High, false);
+    EXPECT_EQ(scheduler.Enqueue(kCmdA, 1, CommandPriority::High, true), 0);
+    EXPECT_EQ(scheduler.GetStats().merged, 1u);
+
+    EXPECT_CALL(mockSdk, CommandOnce(kCmdA)).Times(1);
+    EXPECT_CALL(mockSdk, CommandOnce(kCmdB)).Times(1);
+    scheduler.RunFrame();
+
+    // Once it has run, the command can be queued again
+    EXPECT_EQ(scheduler.Enqueue(kCmdA, 1, CommandPriority::High, true), 1);
+}
+
+TEST(CommandSchedulerTest, Enqueue_CountsDropsWhenFull) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    CommandScheduler scheduler(mockSdk);
+
+    EXPECT_EQ(scheduler.Enqueue(kCmdA, CommandScheduler::kMaxPendingCommands - 1, CommandPriority::Normal, false),
+              static_cast<int>(CommandScheduler::kMaxPendingCommands - 1));
+    EXPECT_EQ(scheduler.Enqueue(kCmdB, 5, CommandPriority::High, false), 1);
+
+    auto stats = scheduler.GetStats();
+    EXPECT_EQ(stats.queueDepth, CommandScheduler::kMaxPendingCommands);
+    EXPECT_EQ(stats.maxQueueDepth, CommandScheduler::kMaxPendingCommands);
+    EXPECT_EQ(stats.dropped, 4u);
+
+    scheduler.Clear();
+    EXPECT_EQ(scheduler.GetStats().queueDepth, 0u);
+}
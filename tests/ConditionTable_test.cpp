@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "ConditionTable.h"
+#include "XPlaneSDK.h"
+#include <bit>
+
+class MockXPlaneSDK : public IXPlaneSDK {
+public:
+    MockXPlaneSDK() {
+        ON_CALL(*this, Log(::testing::_, ::testing::_)).WillByDefault(::testing::Return());
+        ON_CALL(*this, GetLogLevel()).WillByDefault(::testing::Return(LogLevel::Info));
+        ON_CALL(*this, FileExists(::testing::_)).WillByDefault(::testing::Return(true));
+    }
+
+    MOCK_METHOD(void*, FindDataRef, (const char* name), (override));
+    MOCK_METHOD(int, GetDataRefTypes, (void* dataRef), (override));
+    MOCK_METHOD(int, GetDatai, (void* dataRef), (override));
+    MOCK_METHOD(void, SetDatai, (void* dataRef, int value), (override));
+    MOCK_METHOD(float, GetDataf, (void* dataRef), (override));
+    MOCK_METHOD(void, SetDataf, (void* dataRef, float value), (override));
+    MOCK_METHOD(int, GetDataiArray, (void* dataRef, int index), (override));
+    MOCK_METHOD(void, SetDataiArray, (void* dataRef, int value, int index), (override));
+    MOCK_METHOD(float, GetDatafArray, (void* dataRef, int index), (override));
+    MOCK_METHOD(int, GetDataiArrayRange, (void* dataRef, int* outValues, int offset, int count), (override));
+    MOCK_METHOD(int, GetDatafArrayRange, (void* dataRef, float* outValues, int offset, int count), (override));
+    MOCK_METHOD(void, SetDatafArray, (void* dataRef, float value, int index), (override));
+    MOCK_METHOD(int, GetDatab, (void* dataRef, void* outData, int offset, int maxLength), (override));
+    MOCK_METHOD(void*, FindCommand, (const char* name), (override));
+    MOCK_METHOD(void, CommandOnce, (void* commandRef), (override));
+    MOCK_METHOD(void, CommandBegin, (void* commandRef), (override));
+    MOCK_METHOD(void, CommandEnd, (void* commandRef), (override));
+    MOCK_METHOD(void, Log, (LogLevel level, const char* string), (override));
+    MOCK_METHOD(void, SetLogLevel, (LogLevel level), (override));
+    MOCK_METHOD(LogLevel, GetLogLevel, (), (const, override));
+    MOCK_METHOD(float, GetElapsedTime, (), (override));
+    MOCK_METHOD(std::string, GetSystemPath, (), (override));
+    MOCK_METHOD(bool, FileExists, (const std::string& path), (override));
+    MOCK_METHOD(SoundId, LoadSound, (const std::string& path), (override));
+    MOCK_METHOD(void, PlaySound, (SoundId sound), (override));
+    MOCK_METHOD(void, DrawString, (const float color[4], int x, int y, const char* string), (override));
+    MOCK_METHOD(void, DrawRectangle, (const float color[4], int l, int t, int r, int b), (override));
+    MOCK_METHOD(void, DrawRectangleOutline, (const float color[4], int l, int t, int r, int b), (override));
+    MOCK_METHOD(int, MeasureString, (const char* string), (override));
+    MOCK_METHOD(int, GetFontHeight, (), (override));
+    MOCK_METHOD(void, GetScreenSize, (int* outWidth, int* outHeight), (override));
+    MOCK_METHOD(void*, CreateWindowEx, (const WindowCreateParams& params), (override));
+    MOCK_METHOD(void, DestroyWindow, (void* windowId), (override));
+    MOCK_METHOD(void, SetWindowVisible, (void* windowId, int visible), (override));
+    MOCK_METHOD(void, SetWindowGeometry, (void* windowId, int left, int top, int right, int bottom), (override));
+    MOCK_METHOD(void, GetWindowGeometry, (void* windowId, int* outLeft, int* outTop, int* outRight, int* outBottom), (override));
+    MOCK_METHOD(void, GetScreenBoundsGlobal, (int* outLeft, int* outTop, int* outRight, int* outBottom), (override));
+};
+
+using ::testing::Return;
+using ::testing::StrEq;
+
+namespace {
+
+uint64_t Pack(double value) { return std::bit_cast<uint64_t>(value); }
+
+} // namespace
+
+TEST(ConditionTableTest, FlattensNumericTestsIntoRows) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    ConditionEvaluator evaluator(mockSdk);
+    ConditionTable table;
+
+    table.AddRule(0, evaluator.CompileCondition({{"dataref", "sim/test/a"}, {"min", 1}, {"max", 3}}, false));
+    table.AddRule(0, evaluator.CompileCondition({{"dataref", "sim/test/a"}, {"bit", 2}, {"lt", 10}}, false));
+    table.AddRule(1, evaluator.CompileCondition({{"any", {{{"dataref", "sim/test/b"}, {"eq", 1}}}}}, false));
+    table.AddRule(1, evaluator.CompileCondition({{"dataref", "sim/test/c"}, {"string-equals", "x"}}, false));
+
+    EXPECT_EQ(table.GetOutputCount(), 2u);
+    EXPECT_EQ(table.GetRuleCount(), 4u);
+    EXPECT_EQ(table.GetFlatRuleCount(), 2u);
+    // Shared elements are listed once
+    EXPECT_EQ(table.GetDependencies().size(), 3u);
+}
+
+TEST(ConditionTableTest, FirstPassingRuleWinsPerOutput) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    ConditionEvaluator evaluator(mockSdk);
+    ConditionTable table;
+
+    const uint32_t range = table.AddRule(0, evaluator.CompileCondition({{"dataref", "sim/test/a"}, {"min", 1}, {"max", 3}}, false));
+    const uint32_t bit = table.AddRule(0, evaluator.CompileCondition({{"dataref", "sim/test/a"}, {"bit", 2}, {"lt", 10}}, false));
+    const uint32_t notEqual = table.AddRule(1, evaluator.CompileCondition({{"dataref", "sim/test/b"}, {"ne", 0}}, false));
+    const uint32_t greater = table.AddRule(2, evaluator.CompileCondition({{"dataref", "sim/test/b"}, {"gt", 0.5}}, false));
+
+    std::vector<int32_t> firstMatch;
+    table.Evaluate({Pack(2.0), Pack(1.0)}, evaluator, firstMatch);
+    EXPECT_EQ(firstMatch, (std::vector<int32_t>{static_cast<int32_t>(range), static_cast<int32_t>(notEqual), static_cast<int32_t>(greater)}));
+
+    // 6 has bit 2 set and is below 10; 0.5 is not greater than 0.5
+    table.Evaluate({Pack(6.0), Pack(0.5)}, evaluator, firstMatch);
+    EXPECT_EQ(firstMatch, (std::vector<int32_t>{static_cast<int32_t>(bit), static_cast<int32_t>(notEqual), ConditionTable::kNoMatch}));
+
+    // A missing dataref fails every test, including "ne"
+    table.Evaluate({Pack(14.0), ConditionEvaluator::kMissingValue}, evaluator, firstMatch);
+    EXPECT_EQ(firstMatch, (std::vector<int32_t>{ConditionTable::kNoMatch, ConditionTable::kNoMatch, ConditionTable::kNoMatch}));
+}
+
+TEST(ConditionTableTest, GroupsFallBackToTheirTreeOnlyWhenOutputUnmatched) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    DataRefRegistry registry(mockSdk);
+    ConditionEvaluator evaluator(mockSdk, registry);
+    ConditionTable table;
+
+    void* groupDr = reinterpret_cast<void*>(0x2);
+    ON_CALL(mockSdk, FindDataRef(StrEq("sim/test/a"))).WillByDefault(Return(reinterpret_cast<void*>(0x1)));
+    ON_CALL(mockSdk, FindDataRef(StrEq("sim/test/group"))).WillByDefault(Return(groupDr));
+    ON_CALL(mockSdk, GetDataRefTypes(::testing::_)).WillByDefault(Return(1)); // xplmType_Int = 1
+
+    table.AddRule(0, evaluator.CompileCondition({{"dataref", "sim/test/a"}, {"eq", 1}}));
+    const uint32_t group = table.AddRule(0, evaluator.CompileCondition(
+        {{"any", {{{"dataref", "sim/test/group"}, {"eq", 1}}, {{"dataref", "sim/test/group"}, {"eq", 2}}}}}));
+
+    // Output 0 is already matched by the flat rule, so the group is never read
+    std::vector<int32_t> firstMatch;
+    EXPECT_CALL(mockSdk, GetDatai(groupDr)).Times(0);
+    table.Evaluate({Pack(1.0), Pack(2.0)}, evaluator, firstMatch);
+    EXPECT_EQ(firstMatch[0], 0);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+
+    EXPECT_CALL(mockSdk, GetDatai(groupDr)).WillRepeatedly(Return(2));
+    table.Evaluate({Pack(0.0), Pack(2.0)}, evaluator, firstMatch);
+    EXPECT_EQ(firstMatch[0], static_cast<int32_t>(group));
+}
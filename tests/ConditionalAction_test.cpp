@@ -3,6 +3,8 @@
 #include "EventProcessor.h"
 #include "XPlaneSDK.h"
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstring>
 
 class MockXPlaneSDK : public IXPlaneSDK {
 public:
@@ -21,6 +23,8 @@ public:
     MOCK_METHOD(int, GetDataiArray, (void* dataRef, int index), (override));
     MOCK_METHOD(void, SetDataiArray, (void* dataRef, int value, int index), (override));
     MOCK_METHOD(float, GetDatafArray, (void* dataRef, int index), (override));
+    MOCK_METHOD(int, GetDataiArrayRange, (void* dataRef, int* outValues, int offset, int count), (override));
+    MOCK_METHOD(int, GetDatafArrayRange, (void* dataRef, float* outValues, int offset, int count), (override));
     MOCK_METHOD(void, SetDatafArray, (void* dataRef, float value, int index), (override));
     MOCK_METHOD(int, GetDatab, (void* dataRef, void* outData, int offset, int maxLength), (override));
     MOCK_METHOD(void*, FindCommand, (const char* name), (override));
@@ -33,7 +37,8 @@ public:
     MOCK_METHOD(float, GetElapsedTime, (), (override));
     MOCK_METHOD(std::string, GetSystemPath, (), (override));
     MOCK_METHOD(bool, FileExists, (const std::string& path), (override));
-    MOCK_METHOD(void, PlaySound, (const std::string& path), (override));
+    MOCK_METHOD(SoundId, LoadSound, (const std::string& path), (override));
+    MOCK_METHOD(void, PlaySound, (SoundId sound), (override));
     MOCK_METHOD(void, DrawString, (const float color[4], int x, int y, const char* string), (override));
     MOCK_METHOD(void, DrawRectangle, (const float color[4], int l, int t, int r, int b), (override));
     MOCK_METHOD(void, DrawRectangleOutline, (const float color[4], int l, int t, int r, int b), (override));
@@ -169,3 +174,65 @@ TEST(ConditionalActionTest, Condition_ArrayDataRef) {
 
     EXPECT_TRUE(evaluator.EvaluateCondition(condition, false));
 }
+
+TEST(ConditionalActionTest, Condition_GroupsAndComparisons) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    ConditionEvaluator evaluator(mockSdk);
+
+    void* altModeDr = reinterpret_cast<void*>(0x1);
+    void* vsDr = reinterpret_cast<void*>(0x2);
+    ON_CALL(mockSdk, FindDataRef(StrEq("sim/cockpit2/autopilot/altitude_mode"))).WillByDefault(Return(altModeDr));
+    ON_CALL(mockSdk, FindDataRef(StrEq("sim/cockpit2/autopilot/vvi_dial_fpm"))).WillByDefault(Return(vsDr));
+    ON_CALL(mockSdk, GetDataRefTypes(altModeDr)).WillByDefault(Return(static_cast<int>(DataRefType::Int)));
+    ON_CALL(mockSdk, GetDataRefTypes(vsDr)).WillByDefault(Return(static_cast<int>(DataRefType::Float)));
+
+    // VS mode with a climb selected, or any mode other than altitude hold (6)
+    ConditionTree tree = evaluator.CompileCondition({
+        {"any", {
+            {{"all", {
+                {{"dataref", "sim/cockpit2/autopilot/altitude_mode"}, {"eq", 4}},
+                {{"dataref", "sim/cockpit2/autopilot/vvi_dial_fpm"}, {"gt", 0}}
+            }}},
+            {{"not", {{"dataref", "sim/cockpit2/autopilot/altitude_mode"}, {"ne", 6}}}}
+        }}
+    });
+    ASSERT_EQ(tree.nodes.size(), 6u);
+
+    auto check = [&](int altMode, float vs) {
+        ON_CALL(mockSdk, GetDatai(altModeDr)).WillByDefault(Return(altMode));
+        ON_CALL(mockSdk, GetDataf(vsDr)).WillByDefault(Return(vs));
+        return evaluator.Evaluate(tree);
+    };
+    EXPECT_TRUE(check(4, 500.0f));
+    EXPECT_FALSE(check(4, -500.0f));
+    EXPECT_TRUE(check(6, -500.0f));
+    EXPECT_FALSE(check(5, 500.0f));
+
+    // Several tests on one dataref must all pass
+    ON_CALL(mockSdk, GetDataf(vsDr)).WillByDefault(Return(300.0f));
+    EXPECT_TRUE(evaluator.EvaluateCondition({{"dataref", "sim/cockpit2/autopilot/vvi_dial_fpm"}, {"gt", 0}, {"lt", 500}}));
+    EXPECT_FALSE(evaluator.EvaluateCondition({{"dataref", "sim/cockpit2/autopilot/vvi_dial_fpm"}, {"gt", 0}, {"lt", 200}}));
+
+    // A condition with nothing to test never matches
+    EXPECT_FALSE(evaluator.EvaluateCondition({{"dataref", "sim/cockpit2/autopilot/vvi_dial_fpm"}}));
+    EXPECT_FALSE(evaluator.EvaluateCondition({{"not", 1}}));
+}
+
+TEST(ConditionalActionTest, Condition_StringEquals) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    ConditionEvaluator evaluator(mockSdk);
+
+    void* icaoDr = reinterpret_cast<void*>(0x1);
+    ON_CALL(mockSdk, FindDataRef(StrEq("sim/aircraft/view/acf_ICAO"))).WillByDefault(Return(icaoDr));
+    ON_CALL(mockSdk, GetDataRefTypes(icaoDr)).WillByDefault(Return(static_cast<int>(DataRefType::Data)));
+    EXPECT_CALL(mockSdk, GetDatab(icaoDr, ::testing::_, 0, ::testing::_))
+        .Times(2)
+        .WillRepeatedly([](void*, void* out, int, int maxLength) {
+            const char value[] = "C172\0\0\0";
+            std::memcpy(out, value, std::min<size_t>(sizeof(value), static_cast<size_t>(maxLength)));
+            return static_cast<int>(sizeof(value));
+        });
+
+    EXPECT_TRUE(evaluator.EvaluateCondition({{"dataref", "sim/aircraft/view/acf_ICAO"}, {"string-equals", "C172"}}));
+    EXPECT_FALSE(evaluator.EvaluateCondition({{"dataref", "sim/aircraft/view/acf_ICAO"}, {"string-equals", "C17"}}));
+}
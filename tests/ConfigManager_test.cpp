@@ -17,6 +17,8 @@ public:
     MOCK_METHOD(int, GetDataiArray, (void* dataRef, int index), (override));
     MOCK_METHOD(void, SetDataiArray, (void* dataRef, int value, int index), (override));
     MOCK_METHOD(float, GetDatafArray, (void* dataRef, int index), (override));
+    MOCK_METHOD(int, GetDataiArrayRange, (void* dataRef, int* outValues, int offset, int count), (override));
+    MOCK_METHOD(int, GetDatafArrayRange, (void* dataRef, float* outValues, int offset, int count), (override));
     MOCK_METHOD(void, SetDatafArray, (void* dataRef, float value, int index), (override));
     MOCK_METHOD(int, GetDatab, (void* dataRef, void* outData, int offset, int maxLength), (override));
     MOCK_METHOD(void*, FindCommand, (const char* name), (override));
@@ -29,7 +31,8 @@ public:
     MOCK_METHOD(float, GetElapsedTime, (), (override));
     MOCK_METHOD(std::string, GetSystemPath, (), (override));
     MOCK_METHOD(bool, FileExists, (const std::string& path), (override));
-    MOCK_METHOD(void, PlaySound, (const std::string& path), (override));
+    MOCK_METHOD(SoundId, LoadSound, (const std::string& path), (override));
+    MOCK_METHOD(void, PlaySound, (SoundId sound), (override));
     MOCK_METHOD(void, DrawString, (const float color[4], int x, int y, const char* string), (override));
     MOCK_METHOD(void, DrawRectangle, (const float color[4], int l, int t, int r, int b), (override));
     MOCK_METHOD(void, DrawRectangleOutline, (const float color[4], int l, int t, int r, int b), (override));
@@ -176,3 +179,37 @@ TEST_F(ConfigManagerTest, LoadConfigs_VerifiesOutputSectionAtRoot) {
     EXPECT_FALSE(badConfig.contains("output"));
     EXPECT_TRUE(badConfig["modes"].contains("output"));
 }
+
+TEST_F(ConfigManagerTest, ResolveDeviceConfig_AppliesOverridesForMatchingSerial) {
+    nlohmann::json config = {
+        {"name", "Shared"},
+        {"modes", {
+            {"com1", {{"inner-knob", {{"rotate-clockwise", {{"type", "command"}, {"value", "sim/com1_up"}}}}}}},
+            {"nav1", {{"inner-knob", {{"rotate-clockwise", {{"type", "command"}, {"value", "sim/nav1_up"}}}}}}}
+        }},
+        {"devices", {
+            {"UNIT-B", {
+                {"modes", {
+                    {"com1", {{"inner-knob", {{"rotate-clockwise", {{"type", "command"}, {"value", "sim/com2_up"}}}}}}}
+                }}
+            }}
+        }}
+    };
+
+    auto unitB = ConfigManager::ResolveDeviceConfig(config, "UNIT-B");
+    EXPECT_FALSE(unitB.contains("devices"));
+    EXPECT_EQ(unitB["name"], "Shared");
+    EXPECT_EQ(unitB["modes"]["com1"]["inner-knob"]["rotate-clockwise"]["value"], "sim/com2_up");
+    // Sections the override does not mention are inherited
+    EXPECT_EQ(unitB["modes"]["nav1"]["inner-knob"]["rotate-clockwise"]["value"], "sim/nav1_up");
+
+    auto unitA = ConfigManager::ResolveDeviceConfig(config, "UNIT-A");
+    EXPECT_FALSE(unitA.contains("devices"));
+    EXPECT_EQ(unitA["modes"]["com1"]["inner-knob"]["rotate-clockwise"]["value"], "sim/com1_up");
+}
+
+TEST_F(ConfigManagerTest, ResolveDeviceConfig_WithoutDevicesSectionReturnsConfigUnchanged) {
+    nlohmann::json config = {{"name", "Plain"}, {"modes", nlohmann::json::object()}};
+    EXPECT_EQ(ConfigManager::ResolveDeviceConfig(config, "ANY"), config);
+    EXPECT_EQ(ConfigManager::ResolveDeviceConfig(nlohmann::json(), ""), nlohmann::json());
+}
@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "DataRefRegistry.h"
+#include "XPlaneSDK.h"
+
+namespace {
+
+class MockXPlaneSDK : public IXPlaneSDK {
+public:
+    MockXPlaneSDK() {
+        ON_CALL(*this, Log(::testing::_, ::testing::_)).WillByDefault(::testing::Return());
+        ON_CALL(*this, GetLogLevel()).WillByDefault(::testing::Return(LogLevel::Info));
+        ON_CALL(*this, FileExists(::testing::_)).WillByDefault(::testing::Return(true));
+    }
+
+    MOCK_METHOD(void*, FindDataRef, (const char* name), (override));
+    MOCK_METHOD(int, GetDataRefTypes, (void* dataRef), (override));
+    MOCK_METHOD(int, GetDatai, (void* dataRef), (override));
+    MOCK_METHOD(void, SetDatai, (void* dataRef, int value), (override));
+    MOCK_METHOD(float, GetDataf, (void* dataRef), (override));
+    MOCK_METHOD(void, SetDataf, (void* dataRef, float value), (override));
+    MOCK_METHOD(int, GetDataiArray, (void* dataRef, int index), (override));
+    MOCK_METHOD(void, SetDataiArray, (void* dataRef, int value, int index), (override));
+    MOCK_METHOD(float, GetDatafArray, (void* dataRef, int index), (override));
+    MOCK_METHOD(int, GetDataiArrayRange, (void* dataRef, int* outValues, int offset, int count), (override));
+    MOCK_METHOD(int, GetDatafArrayRange, (void* dataRef, float* outValues, int offset, int count), (override));
+    MOCK_METHOD(void, SetDatafArray, (void* dataRef, float value, int index), (override));
+    MOCK_METHOD(int, GetDatab, (void* dataRef, void* outData, int offset, int maxLength), (override));
+    MOCK_METHOD(void*, FindCommand, (const char* name), (override));
+    MOCK_METHOD(void, CommandOnce, (void* commandRef), (override));
+    MOCK_METHOD(void, CommandBegin, (void* commandRef), (override));
+    MOCK_METHOD(void, CommandEnd, (void* commandRef), (override));
+    MOCK_METHOD(void, Log, (LogLevel level, const char* string), (override));
+    MOCK_METHOD(void, SetLogLevel, (LogLevel level), (override));
+    MOCK_METHOD(LogLevel, GetLogLevel, (), (const, override));
+    MOCK_METHOD(float, GetElapsedTime, (), (override));
+    MOCK_METHOD(std::string, GetSystemPath, (), (override));
+    MOCK_METHOD(bool, FileExists, (const std::string& path), (override));
+    MOCK_METHOD(SoundId, LoadSound, (const std::string& path), (override));
+    MOCK_METHOD(void, PlaySound, (SoundId sound), (override));
+    MOCK_METHOD(void, DrawString, (const float color[4], int x, int y, const char* string), (override));
+    MOCK_METHOD(void, DrawRectangle, (const float color[4], int l, int t, int r, int b), (override));
+    MOCK_METHOD(void, DrawRectangleOutline, (const float color[4], int l, int t, int r, int b), (override));
+    MOCK_METHOD(int, MeasureString, (const char* string), (override));
+    MOCK_METHOD(int, GetFontHeight, (), (override));
+    MOCK_METHOD(void, GetScreenSize, (int* outWidth, int* outHeight), (override));
+    MOCK_METHOD(void*, CreateWindowEx, (const WindowCreateParams& params), (override));
+    MOCK_METHOD(void, DestroyWindow, (void* windowId), (override));
+    MOCK_METHOD(void, SetWindowVisible, (void* windowId, int visible), (override));
+    MOCK_METHOD(void, SetWindowGeometry, (void* windowId, int left, int top, int right, int bottom), (override));
+    MOCK_METHOD(void, GetWindowGeometry, (void* windowId, int* outLeft, int* outTop, int* outRight, int* outBottom), (override));
+    MOCK_METHOD(void, GetScreenBoundsGlobal, (int* outLeft, int* outTop, int* outRight, int* outBottom), (override));
+};
+
+void* const kRef = reinterpret_cast<void*>(0x1234);
+
+} // namespace
+
+TEST(DataRefRegistryTest, Intern_SharesOneLookupPerName) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EXPECT_CALL(mockSdk, FindDataRef(::testing::StrEq("sim/test/value"))).Times(1).WillOnce(::testing::Return(kRef));
+    EXPECT_CALL(mockSdk, GetDataRefTypes(kRef)).Times(1).WillOnce(::testing::Return(static_cast<int>(DataRefType::Int)));
+
+    DataRefRegistry registry(mockSdk);
+    DataRefId first = registry.Intern("sim/test/value");
+    DataRefId second = registry.Intern("sim/test/value");
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(registry.Size(), 1u);
+    EXPECT_EQ(registry.Resolve(first), kRef);
+    EXPECT_EQ(registry.Resolve(second), kRef);
+    EXPECT_EQ(registry.GetTypes(first), static_cast<int>(DataRefType::Int));
+    EXPECT_EQ(registry.GetName(first), "sim/test/value");
+}
+
+TEST(DataRefRegistryTest, Resolve_RetriesMissingDataRefWithBackoff) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    float now = 0.0f;
+    ON_CALL(mockSdk, GetElapsedTime()).WillByDefault([&]() { return now; });
+
+    DataRefRegistry registry(mockSdk);
+    EXPECT_CALL(mockSdk, FindDataRef(::testing::StrEq("plugin/late"))).Times(1).WillOnce(::testing::Return(nullptr));
+    DataRefId id = registry.Intern("plugin/late");
+    EXPECT_EQ(registry.Resolve(id), nullptr);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+
+    // Within the first one-second delay nothing is looked up
+    EXPECT_CALL(mockSdk, FindDataRef(::testing::_)).Times(0);
+    now = 0.5f;
+    EXPECT_EQ(registry.Resolve(id), nullptr);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+
+    // Retry after one second, then the delay doubles
+    EXPECT_CALL(mockSdk, FindDataRef(::testing::StrEq("plugin/late"))).Times(1).WillOnce(::testing::Return(nullptr));
+    now = 1.0f;
+    EXPECT_EQ(registry.Resolve(id), nullptr);
+    now = 2.5f;
+    EXPECT_EQ(registry.Resolve(id), nullptr);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+
+    EXPECT_CALL(mockSdk, FindDataRef(::testing::StrEq("plugin/late"))).WillOnce(::testing::Return(kRef));
+    EXPECT_CALL(mockSdk, GetDataRefTypes(kRef)).WillOnce(::testing::Return(static_cast<int>(DataRefType::Float)));
+    now = 3.0f;
+    EXPECT_EQ(registry.Resolve(id), kRef);
+    EXPECT_EQ(registry.GetTypes(id), static_cast<int>(DataRefType::Float));
+}
+
+TEST(DataRefRegistryTest, RetryMissing_ClearsBackoff) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    ON_CALL(mockSdk, GetElapsedTime()).WillByDefault(::testing::Return(10.0f));
+
+    DataRefRegistry registry(mockSdk);
+    EXPECT_CALL(mockSdk, FindDataRef(::testing::StrEq("plugin/late"))).WillOnce(::testing::Return(nullptr));
+    DataRefId id = registry.Intern("plugin/late");
+    EXPECT_EQ(registry.Resolve(id), nullptr);
+    EXPECT_EQ(registry.Resolve(id), nullptr);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+
+    // After an aircraft load the next Resolve looks it up again at once
+    registry.RetryMissing();
+    EXPECT_CALL(mockSdk, FindDataRef(::testing::StrEq("plugin/late"))).WillOnce(::testing::Return(kRef));
+    EXPECT_EQ(registry.Resolve(id), kRef);
+}
+
+TEST(DataRefRegistryTest, ReadValue_FetchesEachValueOncePerFrame) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    ON_CALL(mockSdk, FindDataRef(::testing::_)).WillByDefault(::testing::Return(kRef));
+    ON_CALL(mockSdk, GetDataRefTypes(kRef)).WillByDefault(::testing::Return(static_cast<int>(DataRefType::IntArray)));
+
+    DataRefRegistry registry(mockSdk);
+    DataRefId id = registry.Intern("sim/test/array");
+    ASSERT_EQ(registry.Resolve(id), kRef);
+
+    // Outside a frame every read goes to the SDK
+    EXPECT_CALL(mockSdk, GetDataiArray(kRef, 2)).Times(2).WillRepeatedly(::testing::Return(7));
+    EXPECT_EQ(registry.ReadValue(id, 2), 7.0);
+    EXPECT_EQ(registry.ReadValue(id, 2), 7.0);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+
+    // Inside a frame each element is fetched once
+    EXPECT_CALL(mockSdk, GetDataiArray(kRef, 2)).WillOnce(::testing::Return(8));
+    EXPECT_CALL(mockSdk, GetDataiArray(kRef, 0)).WillOnce(::testing::Return(1));
+    registry.BeginFrame();
+    EXPECT_EQ(registry.ReadValue(id, 2), 8.0);
+    EXPECT_EQ(registry.ReadValue(id, 0), 1.0);
+    EXPECT_EQ(registry.ReadValue(id, 2), 8.0);
+    EXPECT_EQ(registry.ReadValue(id, 0), 1.0);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+
+    // A write by the plugin invalidates the snapshot
+    EXPECT_CALL(mockSdk, GetDataiArray(kRef, 2)).WillOnce(::testing::Return(9));
+    registry.InvalidateValues();
+    EXPECT_EQ(registry.ReadValue(id, 2), 9.0);
+    EXPECT_EQ(registry.ReadValue(id, 2), 9.0);
+    registry.EndFrame();
+}
+
+TEST(DataRefRegistryTest, PrefetchElements_ReadsWindowWithOneCall) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    ON_CALL(mockSdk, FindDataRef(::testing::_)).WillByDefault(::testing::Return(kRef));
+    ON_CALL(mockSdk, GetDataRefTypes(kRef)).WillByDefault(::testing::Return(static_cast<int>(DataRefType::FloatArray)));
+
+    DataRefRegistry registry(mockSdk);
+    DataRefId id = registry.Intern("sim/test/array");
+    ASSERT_EQ(registry.Resolve(id), kRef);
+
+    // Outside a frame there is no snapshot to fill
+    EXPECT_CALL(mockSdk, GetDatafArrayRange(::testing::_, ::testing::_, ::testing::_, ::testing::_)).Times(0);
+    registry.PrefetchElements(id, 1, 3);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+
+    // The SDK returns only two of the three elements; the third is read on its own
+    EXPECT_CALL(mockSdk, GetDatafArrayRange(kRef, ::testing::_, 1, 3))
+        .WillOnce([](void*, float* out, int, int) {
+            out[0] = 1.5f;
+            out[1] = 2.5f;
+            return 2;
+        });
+    EXPECT_CALL(mockSdk, GetDatafArray(kRef, 1)).Times(0);
+    EXPECT_CALL(mockSdk, GetDatafArray(kRef, 2)).Times(0);
+    EXPECT_CALL(mockSdk, GetDatafArray(kRef, 3)).WillOnce(::testing::Return(3.5f));
+    registry.BeginFrame();
+    registry.PrefetchElements(id, 1, 3);
+    registry.PrefetchElements(id, 1, 2); // Already current
+    EXPECT_EQ(registry.ReadValue(id, 1), 1.5);
+    EXPECT_EQ(registry.ReadValue(id, 2), 2.5);
+    EXPECT_EQ(registry.ReadValue(id, 3), 3.5);
+    registry.EndFrame();
+}
+
+TEST(DataRefRegistryTest, WriteValue_HoldsWritesUntilFlush) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    ON_CALL(mockSdk, FindDataRef(::testing::_)).WillByDefault(::testing::Return(kRef));
+    ON_CALL(mockSdk, GetDataRefTypes(kRef)).WillByDefault(::testing::Return(static_cast<int>(DataRefType::Int)));
+
+    DataRefRegistry registry(mockSdk);
+    DataRefId id = registry.Intern("sim/test/int");
+    ASSERT_EQ(registry.Resolve(id), kRef);
+
+    // Outside a frame a write goes straight to the SDK
+    EXPECT_CALL(mockSdk, SetDatai(kRef, 3)).Times(1);
+    registry.WriteValue(id, -1, 3.7);
+    EXPECT_EQ(registry.GetPendingWriteCount(), 0u);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+
+    // Inside a frame writes to one dataref collapse into the last, and reads see it
+    EXPECT_CALL(mockSdk, GetDatai(kRef)).WillOnce(::testing::Return(5));
+    EXPECT_CALL(mockSdk, SetDatai(kRef, ::testing::_)).Times(0);
+    registry.BeginFrame();
+    EXPECT_EQ(registry.ReadValue(id), 5.0);
+    registry.WriteValue(id, -1, 6.0);
+    registry.WriteValue(id, -1, 7.0);
+    EXPECT_EQ(registry.ReadValue(id), 7.0);
+    EXPECT_EQ(registry.GetPendingWriteCount(), 1u);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+
+    EXPECT_CALL(mockSdk, SetDatai(kRef, 7)).Times(1);
+    registry.EndFrame();
+    EXPECT_EQ(registry.GetPendingWriteCount(), 0u);
+}
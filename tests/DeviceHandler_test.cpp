@@ -16,6 +16,11 @@ public:
     MOCK_METHOD(bool, IsConnected, (), (const, override));
     MOCK_METHOD(int, Read, (uint8_t* data, size_t length, int timeoutMs), (override));
     MOCK_METHOD(int, Write, (const uint8_t* data, size_t length), (override));
+    MOCK_METHOD(bool, CanWaitForInput, (), (const, override));
+    MOCK_METHOD(void, WaitForInput, (int timeoutMs), (override));
+    MOCK_METHOD(bool, SupportsHotplug, (), (const, override));
+    MOCK_METHOD(void, WaitForDevice, (int timeoutMs), (override));
+    MOCK_METHOD(void, Wake, (), (override));
 };
 
 class MockXPlaneSDK : public IXPlaneSDK {
@@ -35,6 +40,8 @@ public:
     MOCK_METHOD(int, GetDataiArray, (void* dataRef, int index), (override));
     MOCK_METHOD(void, SetDataiArray, (void* dataRef, int value, int index), (override));
     MOCK_METHOD(float, GetDatafArray, (void* dataRef, int index), (override));
+    MOCK_METHOD(int, GetDataiArrayRange, (void* dataRef, int* outValues, int offset, int count), (override));
+    MOCK_METHOD(int, GetDatafArrayRange, (void* dataRef, float* outValues, int offset, int count), (override));
     MOCK_METHOD(void, SetDatafArray, (void* dataRef, float value, int index), (override));
     MOCK_METHOD(int, GetDatab, (void* dataRef, void* outData, int offset, int maxLength), (override));
     MOCK_METHOD(void*, FindCommand, (const char* name), (override));
@@ -47,7 +54,8 @@ public:
     MOCK_METHOD(float, GetElapsedTime, (), (override));
     MOCK_METHOD(std::string, GetSystemPath, (), (override));
     MOCK_METHOD(bool, FileExists, (const std::string& path), (override));
-    MOCK_METHOD(void, PlaySound, (const std::string& path), (override));
+    MOCK_METHOD(SoundId, LoadSound, (const std::string& path), (override));
+    MOCK_METHOD(void, PlaySound, (SoundId sound), (override));
     MOCK_METHOD(void, DrawString, (const float color[4], int x, int y, const char* string), (override));
     MOCK_METHOD(void, DrawRectangle, (const float color[4], int l, int t, int r, int b), (override));
     MOCK_METHOD(void, DrawRectangleOutline, (const float color[4], int l, int t, int r, int b), (override));
@@ -67,6 +75,15 @@ using ::testing::_;
 using ::testing::SetArgPointee;
 using ::testing::DoAll;
 
+// Base for injected worker-thread timestamps in press-timing tests
+const auto kT0 = std::chrono::steady_clock::time_point{};
+
+// Runs one worker pass with the handler's clock stopped at `now`
+void ProcessHardwareAt(DeviceHandler& handler, std::chrono::steady_clock::time_point now) {
+    handler.SetClock([now] { return now; });
+    handler.ProcessHardware();
+}
+
 TEST(DeviceHandlerTest, Update_ConnectsWhenDisconnected) {
     MockHardwareManager mockHw;
     MockXPlaneSDK mockSdk;
@@ -213,6 +230,53 @@ TEST(DeviceHandlerTest, Update_ProcessesKnobRotation) {
     handler.Update(config, 0.0f);
 }
 
+TEST(DeviceHandlerTest, Update_CoalescesKnobDetentsIntoOneDispatch) {
+    MockHardwareManager mockHw;
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor eventProc(mockSdk);
+    OutputProcessor outputProc(mockSdk);
+    SettingsManager settings("test_settings.json");
+    DeviceHandler handler(mockHw, eventProc, outputProc, settings, mockSdk, false);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"com1", {
+                {"outer-knob", {
+                    {"rotate-clockwise", {
+                        {"actions", {
+                            {{"type", "dataref-adjust"}, {"value", "test/dataref"}, {"adjustment", 1.0}}
+                        }}
+                    }}
+                }}
+            }}
+        }}
+    };
+
+    EXPECT_CALL(mockHw, IsConnected()).WillRepeatedly(Return(true));
+
+    // Two reports (+2 and +3 detents) arrive before the next frame
+    auto readKnob = [](int8_t ticks) {
+        return [ticks](uint8_t* buf, size_t, int) {
+            uint8_t report[IFR1::HID_REPORT_SIZE] = {0, 0, 0, 0, 0, static_cast<uint8_t>(ticks), 0, 0, 0};
+            std::memcpy(buf, report, IFR1::HID_REPORT_SIZE);
+            return static_cast<int>(IFR1::HID_REPORT_SIZE);
+        };
+    };
+    EXPECT_CALL(mockHw, Read(_, _, _))
+        .WillOnce(readKnob(2))
+        .WillOnce(readKnob(3))
+        .WillRepeatedly(Return(0));
+
+    void* dummyDr = reinterpret_cast<void*>(0x1234);
+    EXPECT_CALL(mockSdk, FindDataRef(::testing::StrEq("test/dataref"))).WillOnce(Return(dummyDr));
+    EXPECT_CALL(mockSdk, GetDataRefTypes(dummyDr)).WillOnce(Return(2));
+    EXPECT_CALL(mockSdk, GetDataf(dummyDr)).WillOnce(Return(10.0f));
+    EXPECT_CALL(mockSdk, SetDataf(dummyDr, 15.0f)).Times(1);
+
+    handler.ProcessHardware();
+    handler.Update(config, 0.0f);
+}
+
 TEST(DeviceHandlerTest, Update_ProcessesShortPress) {
     MockHardwareManager mockHw;
     MockXPlaneSDK mockSdk;
@@ -318,12 +382,12 @@ TEST(DeviceHandlerTest, Update_ResetsShiftedOnModeChange) {
             return IFR1::HID_REPORT_SIZE;
         })
         .WillOnce(Return(0));
-    handler.ProcessHardware();
+    ProcessHardwareAt(handler, kT0);
     handler.Update(config, 0.0f);
     
-    // Trigger long press (0.5s)
+    // Trigger long press: classified on the worker from report timestamps
     EXPECT_CALL(mockHw, Read(_, _, _)).WillRepeatedly(Return(0));
-    handler.ProcessHardware();
+    ProcessHardwareAt(handler, kT0 + std::chrono::milliseconds(600));
     handler.Update(config, 0.6f); 
     
     // Now shifted should be true. Verify by rotating outer knob (should trigger hdg_cmd)
@@ -431,7 +495,7 @@ TEST(DeviceHandlerTest, UpdateLEDs_PushesToQueueAndWrites) {
     // UpdateLEDs should detect change and push to queue
     handler.ParseModeDescriptions(config);
     outputProc.ParseOutputConfig(config);
-    handler.UpdateLEDs(1.0f);
+    handler.UpdateLEDs();
     
     // ProcessHardware should pop and write
     EXPECT_CALL(mockHw, Write(::testing::Pointee(IFR1::HID_LED_REPORT_ID), 2))
@@ -479,7 +543,7 @@ TEST(DeviceHandlerTest, Update_OtherButtonLongPressDoesNotPlaySound) {
         })
         .WillOnce(Return(0));
     
-    handler.ProcessHardware();
+    ProcessHardwareAt(handler, kT0);
     handler.Update(config, 0.0f);
     
     // 2. Advance time for long press
@@ -492,16 +556,69 @@ TEST(DeviceHandlerTest, Update_OtherButtonLongPressDoesNotPlaySound) {
     // Should NOT play sound
     EXPECT_CALL(mockSdk, PlaySound(_)).Times(0);
     
-    handler.ProcessHardware();
+    ProcessHardwareAt(handler, kT0 + std::chrono::milliseconds(400));
     handler.Update(config, 0.4f);
 }
 
+TEST(DeviceHandlerTest, ProcessHardware_TimestampsEachReportWhenItIsRead) {
+    ::testing::NiceMock<MockHardwareManager> mockHw;
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor eventProc(mockSdk);
+    OutputProcessor outputProc(mockSdk);
+    SettingsManager settings("test_settings.json");
+    DeviceHandler handler(mockHw, eventProc, outputProc, settings, mockSdk, false);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"com1", {
+                {"swap", {
+                    {"short-press", {{"actions", {{{"type", "command"}, {"value", "short_cmd"}}}}}},
+                    {"long-press", {{"actions", {{{"type", "command"}, {"value", "long_cmd"}}}}}}
+                }}
+            }}
+        }}
+    };
+
+    ON_CALL(mockHw, IsConnected()).WillByDefault(Return(true));
+    ON_CALL(mockHw, Write(_, _)).WillByDefault(Return(2));
+
+    // Every clock reading is 400 ms after the previous one, as if each read
+    // had blocked that long
+    auto clockNow = kT0;
+    handler.SetClock([&clockNow] { return clockNow += std::chrono::milliseconds(400); });
+
+    // Press and release of swap (bit 0 of byte 2) drained in one pass
+    uint8_t pressReport[IFR1::HID_REPORT_SIZE] = {0, 0, 0x01, 0, 0, 0, 0, 0, 0};
+    uint8_t releaseReport[IFR1::HID_REPORT_SIZE] = {0, 0, 0x00, 0, 0, 0, 0, 0, 0};
+    EXPECT_CALL(mockHw, Read(_, _, _))
+        .WillOnce([&](uint8_t* buf, size_t, int) {
+            std::memcpy(buf, pressReport, IFR1::HID_REPORT_SIZE);
+            return IFR1::HID_REPORT_SIZE;
+        })
+        .WillOnce([&](uint8_t* buf, size_t, int) {
+            std::memcpy(buf, releaseReport, IFR1::HID_REPORT_SIZE);
+            return IFR1::HID_REPORT_SIZE;
+        })
+        .WillOnce(Return(0));
+
+    void* longCmd = reinterpret_cast<void*>(0x1234);
+    EXPECT_CALL(mockSdk, FindCommand(::testing::StrEq("long_cmd"))).WillOnce(Return(longCmd));
+    EXPECT_CALL(mockSdk, CommandOnce(longCmd));
+    EXPECT_CALL(mockSdk, FindCommand(::testing::StrEq("short_cmd"))).Times(0);
+
+    handler.ProcessHardware();
+    handler.Update(config, 0.0f);
+}
+
 TEST(DeviceHandlerTest, Update_InnerKnobLongPressPlaysSound) {
     MockHardwareManager mockHw;
     MockXPlaneSDK mockSdk;
     
     EXPECT_CALL(mockSdk, FileExists(::testing::_)).WillRepeatedly(::testing::Return(true));
     EXPECT_CALL(mockSdk, GetSystemPath()).WillRepeatedly(Return("/xplane/"));
+    // Loaded up front so the first click does not wait for the disk
+    const SoundId click = 3;
+    EXPECT_CALL(mockSdk, LoadSound(::testing::StrEq("/xplane/Resources/sounds/systems/click.wav"))).WillOnce(Return(click));
     
     EventProcessor eventProc(mockSdk);
     OutputProcessor outputProc(mockSdk);
@@ -525,14 +642,14 @@ TEST(DeviceHandlerTest, Update_InnerKnobLongPressPlaysSound) {
         })
         .WillOnce(Return(0));
     
-    handler.ProcessHardware();
+    ProcessHardwareAt(handler, kT0);
     handler.Update(config, 0.0f);
     
     EXPECT_CALL(mockHw, Read(_, _, _)).WillRepeatedly(Return(0));
     // Should play sound for inner knob
-    EXPECT_CALL(mockSdk, PlaySound(::testing::StrEq("/xplane/Resources/sounds/systems/click.wav")));
+    EXPECT_CALL(mockSdk, PlaySound(click));
     
-    handler.ProcessHardware();
+    ProcessHardwareAt(handler, kT0 + std::chrono::milliseconds(400));
     handler.Update(config, 0.4f);
 }
 
@@ -543,6 +660,7 @@ TEST(DeviceHandlerTest, Update_InnerKnobLongPressDoesNotPlaySoundIfFileNotFound)
     EXPECT_CALL(mockSdk, GetSystemPath()).WillRepeatedly(Return("/xplane/"));
     EXPECT_CALL(mockSdk, FileExists(::testing::StrEq("/xplane/Resources/sounds/systems/click.wav")))
         .WillOnce(Return(false));
+    EXPECT_CALL(mockSdk, LoadSound(_)).Times(0);
     
     EventProcessor eventProc(mockSdk);
     OutputProcessor outputProc(mockSdk);
@@ -566,17 +684,284 @@ TEST(DeviceHandlerTest, Update_InnerKnobLongPressDoesNotPlaySoundIfFileNotFound)
         })
         .WillOnce(Return(0));
     
-    handler.ProcessHardware();
+    ProcessHardwareAt(handler, kT0);
     handler.Update(config, 0.0f);
     
     EXPECT_CALL(mockHw, Read(_, _, _)).WillRepeatedly(Return(0));
     // Should NOT play sound if file not found
     EXPECT_CALL(mockSdk, PlaySound(_)).Times(0);
     
-    handler.ProcessHardware();
+    ProcessHardwareAt(handler, kT0 + std::chrono::milliseconds(400));
     handler.Update(config, 0.4f);
 }
 
+TEST(DeviceHandlerTest, ProcessHardware_ClassifiesLongPressFromReportTimestamps) {
+    MockHardwareManager mockHw;
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor eventProc(mockSdk);
+    OutputProcessor outputProc(mockSdk);
+    SettingsManager settings("test_settings.json");
+    DeviceHandler handler(mockHw, eventProc, outputProc, settings, mockSdk, false);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"com1", {
+                {"swap", {
+                    {"short-press", {{"actions", {{{"type", "command"}, {"value", "short_cmd"}}}}}},
+                    {"long-press", {{"actions", {{{"type", "command"}, {"value", "long_cmd"}}}}}}
+                }}
+            }}
+        }}
+    };
+
+    EXPECT_CALL(mockHw, IsConnected()).WillRepeatedly(Return(true));
+
+    uint8_t pressReport[IFR1::HID_REPORT_SIZE] = {0, 0, 0x01, 0, 0, 0, 0, 0, 0};
+    EXPECT_CALL(mockHw, Read(_, _, _))
+        .WillOnce([&](uint8_t* buf, size_t, int) {
+            std::memcpy(buf, pressReport, IFR1::HID_REPORT_SIZE);
+            return static_cast<int>(IFR1::HID_REPORT_SIZE);
+        })
+        .WillRepeatedly(Return(0));
+
+    void* longCmd = reinterpret_cast<void*>(0x1);
+    EXPECT_CALL(mockSdk, FindCommand(::testing::StrEq("short_cmd"))).Times(0);
+
+    // A long sim stutter between frames must not turn a 100 ms hold into a long press
+    ProcessHardwareAt(handler, kT0);
+    handler.Update(config, 0.0f);
+    ProcessHardwareAt(handler, kT0 + std::chrono::milliseconds(100));
+    handler.Update(config, 5.0f);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+
+    // Crossing the threshold on the worker clock fires the long press immediately
+    EXPECT_CALL(mockSdk, FindCommand(::testing::StrEq("long_cmd"))).WillOnce(Return(longCmd));
+    EXPECT_CALL(mockSdk, CommandOnce(longCmd));
+    ProcessHardwareAt(handler, kT0 + std::chrono::milliseconds(300));
+    handler.Update(config, 5.01f);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+
+    // Releasing after a long press does not also produce a short press
+    uint8_t releaseReport[IFR1::HID_REPORT_SIZE] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    EXPECT_CALL(mockHw, Read(_, _, _))
+        .WillOnce([&](uint8_t* buf, size_t, int) {
+            std::memcpy(buf, releaseReport, IFR1::HID_REPORT_SIZE);
+            return static_cast<int>(IFR1::HID_REPORT_SIZE);
+        })
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(mockSdk, FindCommand(_)).Times(0);
+    ProcessHardwareAt(handler, kT0 + std::chrono::milliseconds(500));
+    handler.Update(config, 5.02f);
+}
+
+TEST(DeviceHandlerTest, ProcessHardware_UsesDeviceProfileLayout) {
+    MockHardwareManager mockHw;
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor eventProc(mockSdk);
+    OutputProcessor outputProc(mockSdk);
+    SettingsManager settings("test_settings.json");
+
+    // A 4-byte panel: report ID, buttons in byte 1, knob in the low nibble of byte 2, no LEDs
+    std::string error;
+    auto profile = DeviceProfile::Compile({
+        {"vendor-id", "0x1234"},
+        {"product-id", "0x5678"},
+        {"report-size", 4},
+        {"buttons", {{"swap", {{"byte", 1}, {"mask", "0x80"}}}}},
+        {"knobs", {{"outer-knob", {{"byte", 2}, {"mask", "0x0F"}}}}}
+    }, error);
+    ASSERT_TRUE(profile.has_value()) << error;
+    DeviceHandler handler(mockHw, eventProc, outputProc, settings, mockSdk, false, *profile);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"com1", {
+                {"swap", {{"short-press", {{"actions", {{{"type", "command"}, {"value", "swap_cmd"}}}}}}}},
+                {"outer-knob", {{"rotate-counterclockwise", {{"actions", {{{"type", "command"}, {"value", "ccw_cmd"}}}}}}}}
+            }}
+        }}
+    };
+
+    EXPECT_CALL(mockHw, IsConnected()).WillOnce(Return(false)).WillRepeatedly(Return(true));
+    EXPECT_CALL(mockHw, Connect(0x1234, 0x5678)).WillOnce(Return(true));
+    // No LED report is configured, so nothing is ever written
+    EXPECT_CALL(mockHw, Write(_, _)).Times(0);
+
+    auto readReport = [](std::array<uint8_t, 4> report) {
+        return [report](uint8_t* buf, size_t len, int) {
+            EXPECT_EQ(len, 4u);
+            std::memcpy(buf, report.data(), report.size());
+            return static_cast<int>(report.size());
+        };
+    };
+    EXPECT_CALL(mockHw, Read(_, _, _))
+        .WillOnce(readReport({0, 0x80, 0x0F, 0}))   // swap down, knob -1 (4-bit two's complement)
+        .WillOnce(readReport({0, 0x00, 0x00, 0}))   // swap up
+        .WillRepeatedly(Return(0));
+
+    EXPECT_CALL(mockSdk, FindCommand(::testing::StrEq("ccw_cmd"))).WillOnce(Return(reinterpret_cast<void*>(0x1)));
+    EXPECT_CALL(mockSdk, FindCommand(::testing::StrEq("swap_cmd"))).WillOnce(Return(reinterpret_cast<void*>(0x2)));
+
+    ProcessHardwareAt(handler, kT0);
+    handler.ClearLEDs();
+    ProcessHardwareAt(handler, kT0);
+    handler.Update(config, 0.0f);
+}
+
+TEST(DeviceHandlerTest, Update_ReleasingSeveralButtonsAtOnceSendsEachShortPress) {
+    MockHardwareManager mockHw;
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor eventProc(mockSdk);
+    OutputProcessor outputProc(mockSdk);
+    SettingsManager settings("test_settings.json");
+    DeviceHandler handler(mockHw, eventProc, outputProc, settings, mockSdk, false);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"com1", {
+                {"swap", {{"short-press", {{"actions", {{{"type", "command"}, {"value", "swap_cmd"}}}}}}}},
+                {"vs", {{"short-press", {{"actions", {{{"type", "command"}, {"value", "vs_cmd"}}}}}}}}
+            }}
+        }}
+    };
+
+    EXPECT_CALL(mockHw, IsConnected()).WillRepeatedly(Return(true));
+
+    uint8_t pressed[IFR1::HID_REPORT_SIZE] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    pressed[2] |= (1 << (IFR1::BitPosition::SWAP - 1));
+    pressed[3] |= (1 << (IFR1::BitPosition::VS - 1));
+    uint8_t released[IFR1::HID_REPORT_SIZE] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    auto readReport = [](const uint8_t* report) {
+        return [report](uint8_t* buf, size_t, int) {
+            std::memcpy(buf, report, IFR1::HID_REPORT_SIZE);
+            return static_cast<int>(IFR1::HID_REPORT_SIZE);
+        };
+    };
+    // The duplicate press report is skipped without affecting classification
+    EXPECT_CALL(mockHw, Read(_, _, _))
+        .WillOnce(readReport(pressed))
+        .WillOnce(readReport(pressed))
+        .WillOnce(readReport(released))
+        .WillRepeatedly(Return(0));
+
+    EXPECT_CALL(mockSdk, FindCommand(::testing::StrEq("swap_cmd"))).WillOnce(Return(reinterpret_cast<void*>(0x1)));
+    EXPECT_CALL(mockSdk, FindCommand(::testing::StrEq("vs_cmd"))).WillOnce(Return(reinterpret_cast<void*>(0x2)));
+
+    ProcessHardwareAt(handler, kT0);
+    handler.Update(config, 0.0f);
+}
+
+TEST(DeviceHandlerTest, Update_PressBeginsHoldAndReleaseEndsIt) {
+    MockHardwareManager mockHw;
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor eventProc(mockSdk);
+    OutputProcessor outputProc(mockSdk);
+    SettingsManager settings("test_settings.json");
+    DeviceHandler handler(mockHw, eventProc, outputProc, settings, mockSdk, false);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"com1", {
+                {"swap", {{"press", {{"actions", {{{"type", "hold"}, {"value", "swap_cmd"}}}}}}}}
+            }}
+        }}
+    };
+    void* swapCmd = reinterpret_cast<void*>(0x1);
+    ON_CALL(mockSdk, FindCommand(::testing::StrEq("swap_cmd"))).WillByDefault(Return(swapCmd));
+    EXPECT_CALL(mockHw, IsConnected()).WillRepeatedly(Return(true));
+
+    uint8_t pressed[IFR1::HID_REPORT_SIZE] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    pressed[2] |= (1 << (IFR1::BitPosition::SWAP - 1));
+    uint8_t released[IFR1::HID_REPORT_SIZE] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+    auto readReport = [](const uint8_t* report) {
+        return [report](uint8_t* buf, size_t, int) {
+            std::memcpy(buf, report, IFR1::HID_REPORT_SIZE);
+            return static_cast<int>(IFR1::HID_REPORT_SIZE);
+        };
+    };
+
+    EXPECT_CALL(mockHw, Read(_, _, _)).WillOnce(readReport(pressed)).WillRepeatedly(Return(0));
+    EXPECT_CALL(mockSdk, CommandBegin(swapCmd)).Times(1);
+    EXPECT_CALL(mockSdk, CommandEnd(swapCmd)).Times(0);
+    handler.ProcessHardware();
+    handler.Update(config, 0.0f);
+    EXPECT_EQ(eventProc.GetActiveHoldCount(), 1u);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+    ::testing::Mock::VerifyAndClearExpectations(&mockHw);
+
+    EXPECT_CALL(mockHw, IsConnected()).WillRepeatedly(Return(true));
+    EXPECT_CALL(mockHw, Read(_, _, _)).WillOnce(readReport(released)).WillRepeatedly(Return(0));
+    EXPECT_CALL(mockSdk, CommandEnd(swapCmd)).Times(1);
+    handler.ProcessHardware();
+    handler.Update(config, 0.1f);
+    EXPECT_EQ(eventProc.GetActiveHoldCount(), 0u);
+}
+
+TEST(DeviceHandlerTest, Update_ShiftToggleCancelsSequencesAndReleasesHolds) {
+    ::testing::NiceMock<MockHardwareManager> mockHw;
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor eventProc(mockSdk);
+    OutputProcessor outputProc(mockSdk);
+    SettingsManager settings("test_settings.json");
+    DeviceHandler handler(mockHw, eventProc, outputProc, settings, mockSdk, false);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"com1", {
+                {"swap", {{"press", {{"actions", {{{"type", "hold"}, {"value", "swap_cmd"}}}}}}}},
+                {"direct-to", {
+                    {"short-press", {
+                        {"actions", {{
+                            {"type", "sequence"},
+                            {"steps", {
+                                {{"wait-ms", 5000}},
+                                {{"type", "command"}, {"value", "direct_cmd"}}
+                            }}
+                        }}}
+                    }}
+                }}
+            }}
+        }}
+    };
+    void* swapCmd = reinterpret_cast<void*>(0x1);
+    ON_CALL(mockSdk, FindCommand(::testing::StrEq("swap_cmd"))).WillByDefault(Return(swapCmd));
+    ON_CALL(mockHw, IsConnected()).WillByDefault(Return(true));
+    ON_CALL(mockHw, Write(_, _)).WillByDefault(Return(2));
+
+    const uint8_t swap = 1 << (IFR1::BitPosition::SWAP - 1);
+    const uint8_t inner = 1 << (IFR1::BitPosition::INNER_KNOB - 1);
+    const uint8_t direct = 1 << (IFR1::BitPosition::DIRECT - 1);
+    auto pass = [&](uint8_t right, uint8_t bottomLeft, std::chrono::milliseconds at, float currentTime) {
+        uint8_t report[IFR1::HID_REPORT_SIZE] = {0, right, bottomLeft, 0, 0, 0, 0, 0, 0};
+        EXPECT_CALL(mockHw, Read(_, _, _))
+            .WillOnce([report](uint8_t* buf, size_t, int) {
+                std::memcpy(buf, report, IFR1::HID_REPORT_SIZE);
+                return static_cast<int>(IFR1::HID_REPORT_SIZE);
+            })
+            .WillRepeatedly(Return(0));
+        ProcessHardwareAt(handler, kT0 + at);
+        handler.Update(config, currentTime);
+    };
+
+    // Hold swap, then start a sequence with a short press of direct
+    EXPECT_CALL(mockSdk, CommandBegin(swapCmd)).Times(1);
+    pass(0, swap, std::chrono::milliseconds(0), 0.0f);
+    pass(direct, swap, std::chrono::milliseconds(50), 0.05f);
+    pass(0, swap, std::chrono::milliseconds(100), 0.1f);
+    ASSERT_EQ(eventProc.GetActiveHoldCount(), 1u);
+    ASSERT_EQ(eventProc.GetActiveSequenceCount(), 1u);
+
+    // Long-pressing the inner knob switches to com1_shifted, a different mode
+    EXPECT_CALL(mockSdk, CommandEnd(swapCmd)).Times(1);
+    pass(0, swap | inner, std::chrono::milliseconds(200), 0.2f);
+    EXPECT_CALL(mockHw, Read(_, _, _)).WillRepeatedly(Return(0));
+    ProcessHardwareAt(handler, kT0 + std::chrono::milliseconds(600));
+    handler.Update(config, 0.6f);
+
+    EXPECT_EQ(eventProc.GetActiveHoldCount(), 0u);
+    EXPECT_EQ(eventProc.GetActiveSequenceCount(), 0u);
+}
+
 TEST(DeviceHandlerTest, Update_UsesNewButtonNamesInFMSMode) {
     MockHardwareManager mockHw;
     MockXPlaneSDK mockSdk;
@@ -639,4 +1024,309 @@ TEST(DeviceHandlerTest, Update_UsesNewButtonNamesInFMSMode) {
     testButton(3, IFR1::BitPosition::ALT, "vnav_cmd");
     testButton(3, IFR1::BitPosition::VS, "proc_cmd");
 }
+
+TEST(DeviceHandlerTest, UpdateLEDs_WakesWorkerWhenStateChanges) {
+    ::testing::NiceMock<MockHardwareManager> mockHw;
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor eventProc(mockSdk);
+    OutputProcessor outputProc(mockSdk);
+    SettingsManager settings("test_settings.json");
+    DeviceHandler handler(mockHw, eventProc, outputProc, settings, mockSdk, false);
+
+    nlohmann::json config = {
+        {"output", {
+            {"ap", {
+                {"conditions", nlohmann::json::array({
+                    {{"dataref", "sim/test/ap"}, {"min", 1}, {"max", 1}, {"mode", "solid"}}
+                })}
+            }}
+        }}
+    };
+
+    ON_CALL(mockHw, IsConnected()).WillByDefault(Return(true));
+    ON_CALL(mockHw, Read(_, _, _)).WillByDefault(Return(0));
+    ON_CALL(mockHw, Write(_, _)).WillByDefault(Return(2));
+    ON_CALL(mockSdk, FindDataRef(_)).WillByDefault(Return(reinterpret_cast<void*>(0x1)));
+    ON_CALL(mockSdk, GetDataRefTypes(_)).WillByDefault(Return(static_cast<int>(DataRefType::Int)));
+    ON_CALL(mockSdk, GetDatai(_)).WillByDefault(Return(1));
+
+    handler.ProcessHardware();
+    outputProc.ParseOutputConfig(config);
+
+    // First evaluation changes the LED state and must wake the worker;
+    // an unchanged state on the next frame must not
+    EXPECT_CALL(mockHw, Wake()).Times(1);
+    handler.UpdateLEDs();
+    handler.UpdateLEDs();
+    ::testing::Mock::VerifyAndClearExpectations(&mockHw);
+}
+
+TEST(DeviceHandlerTest, ProcessHardware_WritesOnlyNewestLedStateWhenItDiffers) {
+    ::testing::NiceMock<MockHardwareManager> mockHw;
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor eventProc(mockSdk);
+    OutputProcessor outputProc(mockSdk);
+    SettingsManager settings("test_settings.json");
+    DeviceHandler handler(mockHw, eventProc, outputProc, settings, mockSdk, false);
+
+    nlohmann::json config = {
+        {"output", {
+            {"ap", {
+                {"conditions", nlohmann::json::array({
+                    {{"dataref", "sim/test/ap"}, {"eq", 1}, {"mode", "solid"}}
+                })}
+            }}
+        }}
+    };
+
+    int ap = 0;
+    ON_CALL(mockHw, IsConnected()).WillByDefault(Return(true));
+    ON_CALL(mockHw, Read(_, _, _)).WillByDefault(Return(0));
+    ON_CALL(mockSdk, FindDataRef(_)).WillByDefault(Return(reinterpret_cast<void*>(0x1)));
+    ON_CALL(mockSdk, GetDataRefTypes(_)).WillByDefault(Return(static_cast<int>(DataRefType::Int)));
+    ON_CALL(mockSdk, GetDatai(_)).WillByDefault([&]() { return ap; });
+
+    handler.ProcessHardware();
+    outputProc.ParseOutputConfig(config);
+
+    std::vector<uint8_t> written;
+    ON_CALL(mockHw, Write(_, 2)).WillByDefault([&](const uint8_t* data, size_t) {
+        written.push_back(data[1]);
+        return 2;
+    });
+
+    // The AP LED flaps on and off between two worker passes: only the newest
+    // state is written
+    handler.ClearLEDs();
+    ap = 1;
+    handler.UpdateLEDs();
+    ap = 0;
+    handler.UpdateLEDs();
+    handler.ProcessHardware();
+    EXPECT_EQ(written, (std::vector<uint8_t>{IFR1::LEDMask::OFF}));
+
+    // It flaps again and settles where the device already is: nothing to write
+    ap = 1;
+    handler.UpdateLEDs();
+    ap = 0;
+    handler.UpdateLEDs();
+    handler.ProcessHardware();
+    EXPECT_EQ(written, (std::vector<uint8_t>{IFR1::LEDMask::OFF}));
+
+    ap = 1;
+    handler.UpdateLEDs();
+    handler.ProcessHardware();
+    EXPECT_EQ(written, (std::vector<uint8_t>{IFR1::LEDMask::OFF, IFR1::LEDMask::AP}));
+}
+
+TEST(DeviceHandlerTest, ProcessHardware_RendersBlinkEdgesFromWorkerClock) {
+    ::testing::NiceMock<MockHardwareManager> mockHw;
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor eventProc(mockSdk);
+    OutputProcessor outputProc(mockSdk);
+    SettingsManager settings("test_settings.json");
+    DeviceHandler handler(mockHw, eventProc, outputProc, settings, mockSdk, false);
+
+    nlohmann::json config = {
+        {"output", {
+            {"alt", {
+                {"conditions", nlohmann::json::array({
+                    {{"dataref", "sim/test/alt"}, {"eq", 1}, {"mode", "blink"}, {"blink-rate", 1.0}}
+                })}
+            }}
+        }}
+    };
+
+    ON_CALL(mockHw, IsConnected()).WillByDefault(Return(true));
+    ON_CALL(mockHw, Read(_, _, _)).WillByDefault(Return(0));
+    ON_CALL(mockSdk, FindDataRef(_)).WillByDefault(Return(reinterpret_cast<void*>(0x1)));
+    ON_CALL(mockSdk, GetDataRefTypes(_)).WillByDefault(Return(static_cast<int>(DataRefType::Int)));
+    ON_CALL(mockSdk, GetDatai(_)).WillByDefault(Return(1));
+
+    ProcessHardwareAt(handler, kT0);
+    outputProc.ParseOutputConfig(config);
+    handler.UpdateLEDs();
+
+    std::vector<uint8_t> written;
+    ON_CALL(mockHw, Write(_, 2)).WillByDefault([&](const uint8_t* data, size_t) {
+        written.push_back(data[1]);
+        return 2;
+    });
+
+    // The program is published once; the worker toggles the LED at each
+    // half-second edge and writes nothing in between
+    using std::chrono::milliseconds;
+    ProcessHardwareAt(handler, kT0 + milliseconds(100));
+    ProcessHardwareAt(handler, kT0 + milliseconds(400));
+    ProcessHardwareAt(handler, kT0 + milliseconds(500));
+    ProcessHardwareAt(handler, kT0 + milliseconds(900));
+    ProcessHardwareAt(handler, kT0 + milliseconds(1000));
+    EXPECT_EQ(written, (std::vector<uint8_t>{IFR1::LEDMask::ALT, IFR1::LEDMask::OFF, IFR1::LEDMask::ALT}));
+}
+
+TEST(DeviceHandlerTest, ProcessHardware_WaitingBackendReadsWithoutTimeout) {
+    MockHardwareManager mockHw;
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor eventProc(mockSdk);
+    OutputProcessor outputProc(mockSdk);
+    SettingsManager settings("test_settings.json");
+    DeviceHandler handler(mockHw, eventProc, outputProc, settings, mockSdk, false);
+
+    EXPECT_CALL(mockHw, IsConnected()).WillRepeatedly(Return(true));
+    EXPECT_CALL(mockHw, CanWaitForInput()).WillRepeatedly(Return(true));
+    EXPECT_CALL(mockHw, Read(_, _, 0)).WillOnce(Return(0));
+    EXPECT_CALL(mockHw, Wake()).Times(::testing::AnyNumber());
+
+    handler.ProcessHardware();
+}
+
+TEST(DeviceHandlerTest, ProcessHardware_DrainsEveryPendingReport) {
+    MockHardwareManager mockHw;
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor eventProc(mockSdk);
+    OutputProcessor outputProc(mockSdk);
+    SettingsManager settings("test_settings.json");
+    DeviceHandler handler(mockHw, eventProc, outputProc, settings, mockSdk, false);
+
+    EXPECT_CALL(mockHw, IsConnected()).WillRepeatedly(Return(true));
+    EXPECT_CALL(mockHw, CanWaitForInput()).WillRepeatedly(Return(false));
+
+    // A burst of 25 knob reports is read in one pass; only the first read may block
+    uint8_t report[IFR1::HID_REPORT_SIZE] = {0, 0, 0, 0, 0, 1, 0, 0, 0};
+    auto readReport = [&](uint8_t* buf, size_t, int) {
+        std::memcpy(buf, report, IFR1::HID_REPORT_SIZE);
+        return static_cast<int>(IFR1::HID_REPORT_SIZE);
+    };
+    ::testing::InSequence seq;
+    EXPECT_CALL(mockHw, Read(_, _, 10)).WillOnce(readReport);
+    EXPECT_CALL(mockHw, Read(_, _, 0)).Times(24).WillRepeatedly(readReport);
+    EXPECT_CALL(mockHw, Read(_, _, 0)).WillOnce(Return(0));
+
+    handler.ProcessHardware();
+
+    auto stats = handler.GetInputStats();
+    EXPECT_EQ(stats.wakeups, 1u);
+    EXPECT_EQ(stats.reportsRead, 25u);
+    EXPECT_EQ(stats.lastReportsPerWakeup, 25u);
+    EXPECT_EQ(stats.maxReportsPerWakeup, 25u);
+    EXPECT_EQ(stats.backpressureStalls, 0u);
+    EXPECT_EQ(stats.droppedEvents, 0u);
+}
+
+TEST(DeviceHandlerTest, ProcessHardware_StopsReadingWhenInputQueueBacksUp) {
+    MockHardwareManager mockHw;
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor eventProc(mockSdk);
+    OutputProcessor outputProc(mockSdk);
+    SettingsManager settings("test_settings.json");
+    DeviceHandler handler(mockHw, eventProc, outputProc, settings, mockSdk, false);
+
+    EXPECT_CALL(mockHw, IsConnected()).WillRepeatedly(Return(true));
+    EXPECT_CALL(mockHw, CanWaitForInput()).WillRepeatedly(Return(true));
+
+    // The device always has another knob report ready
+    uint8_t report[IFR1::HID_REPORT_SIZE] = {0, 0, 0, 0, 0, 1, 0, 0, 0};
+    EXPECT_CALL(mockHw, Read(_, _, _)).WillRepeatedly([&](uint8_t* buf, size_t, int) {
+        std::memcpy(buf, report, IFR1::HID_REPORT_SIZE);
+        return static_cast<int>(IFR1::HID_REPORT_SIZE);
+    });
+
+    handler.ProcessHardware();
+    auto stats = handler.GetInputStats();
+    EXPECT_EQ(stats.backpressureStalls, 1u);
+    EXPECT_GT(stats.reportsRead, 0u);
+    EXPECT_LT(stats.reportsRead, 256u);
+    EXPECT_EQ(stats.droppedEvents, 0u);
+
+    // Once the flight loop consumes the queue the worker reads again
+    handler.Update(nlohmann::json::object(), 0.0f);
+    handler.ProcessHardware();
+    auto after = handler.GetInputStats();
+    EXPECT_EQ(after.backpressureStalls, 2u);
+    EXPECT_EQ(after.reportsRead, 2 * stats.reportsRead);
+    EXPECT_EQ(after.droppedEvents, 0u);
+}
+
+TEST(DeviceHandlerTest, Worker_SleepsWhileBackpressuredUntilFlightLoopDrains) {
+    ::testing::NiceMock<MockHardwareManager> mockHw;
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor eventProc(mockSdk);
+    OutputProcessor outputProc(mockSdk);
+    SettingsManager settings("test_settings.json");
+
+    ON_CALL(mockHw, IsConnected()).WillByDefault(Return(true));
+    ON_CALL(mockHw, CanWaitForInput()).WillByDefault(Return(true));
+    ON_CALL(mockHw, Write(_, _)).WillByDefault(Return(2));
+    uint8_t report[IFR1::HID_REPORT_SIZE] = {0, 0, 0, 0, 0, 1, 0, 0, 0};
+    ON_CALL(mockHw, Read(_, _, _)).WillByDefault([&](uint8_t* buf, size_t, int) {
+        std::memcpy(buf, report, IFR1::HID_REPORT_SIZE);
+        return static_cast<int>(IFR1::HID_REPORT_SIZE);
+    });
+
+    DeviceHandler handler(mockHw, eventProc, outputProc, settings, mockSdk, true);
+    auto waitForStalls = [&](uint64_t count) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (handler.GetInputStats().backpressureStalls < count && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return handler.GetInputStats().backpressureStalls;
+    };
+    ASSERT_EQ(waitForStalls(1), 1u);
+
+    // Nobody drains the queue (no aircraft loaded), so the worker must stay asleep
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(handler.GetInputStats().backpressureStalls, 1u);
+
+    // Draining it lets the worker read again
+    handler.Update(nlohmann::json::object(), 0.0f);
+    EXPECT_GE(waitForStalls(2), 2u);
+}
+
+TEST(DeviceHandlerTest, ProcessHardware_WritesLEDsBeforeBlockingRead) {
+    MockHardwareManager mockHw;
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor eventProc(mockSdk);
+    OutputProcessor outputProc(mockSdk);
+    SettingsManager settings("test_settings.json");
+    DeviceHandler handler(mockHw, eventProc, outputProc, settings, mockSdk, false);
+
+    EXPECT_CALL(mockHw, IsConnected()).WillRepeatedly(Return(true));
+    EXPECT_CALL(mockHw, Wake()).Times(::testing::AnyNumber());
+
+    handler.ClearLEDs();
+
+    // The LED write must go out before the read that may block for its timeout
+    ::testing::InSequence seq;
+    EXPECT_CALL(mockHw, Write(::testing::Pointee(IFR1::HID_LED_REPORT_ID), 2)).WillOnce(Return(2));
+    EXPECT_CALL(mockHw, Read(_, _, _)).WillOnce(Return(0));
+
+    handler.ProcessHardware();
+}
+
+TEST(DeviceHandlerTest, Worker_WaitsForHotplugWhileDisconnected) {
+    ::testing::NiceMock<MockHardwareManager> mockHw;
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor eventProc(mockSdk);
+    OutputProcessor outputProc(mockSdk);
+    SettingsManager settings("test_settings.json");
+
+    ON_CALL(mockHw, IsConnected()).WillByDefault(Return(false));
+    ON_CALL(mockHw, Connect(_, _)).WillByDefault(Return(false));
+    ON_CALL(mockHw, SupportsHotplug()).WillByDefault(Return(true));
+
+    // While unplugged the worker must block in WaitForDevice rather than spin on Connect
+    std::atomic<int> waits{0};
+    EXPECT_CALL(mockHw, WaitForDevice(_)).WillRepeatedly([&waits](int) {
+        ++waits;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    });
+
+    {
+        DeviceHandler handler(mockHw, eventProc, outputProc, settings, mockSdk, true);
+        std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    }
+
+    EXPECT_GE(waits.load(), 1);
+    EXPECT_LE(waits.load(), 4);
+}
 }
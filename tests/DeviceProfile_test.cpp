@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "DeviceProfile.h"
+#include "IFR1Protocol.h"
+
+namespace {
+
+uint16_t ButtonBit(IFR1::Button button) {
+    return static_cast<uint16_t>(1u << static_cast<int>(button));
+}
+
+} // namespace
+
+TEST(DeviceProfileTest, BuiltInIFR1MatchesProtocolConstants) {
+    const auto& profile = DeviceProfile::IFR1();
+    EXPECT_EQ(profile.GetVendorId(), IFR1::VENDOR_ID);
+    EXPECT_EQ(profile.GetProductId(), IFR1::PRODUCT_ID);
+    EXPECT_EQ(profile.GetReportSize(), IFR1::HID_REPORT_SIZE);
+    EXPECT_EQ(profile.GetMinReportLength(), 8u);
+    ASSERT_TRUE(profile.HasLEDs());
+    EXPECT_EQ(profile.GetLEDReportId(), IFR1::HID_LED_REPORT_ID);
+}
+
+TEST(DeviceProfileTest, BuiltInIFR1DecodesReport) {
+    uint8_t report[IFR1::HID_REPORT_SIZE] = {};
+    report[1] = 1 << (IFR1::BitPosition::ENT - 1);
+    report[2] = (1 << (IFR1::BitPosition::INNER_KNOB - 1)) | (1 << (IFR1::BitPosition::HDG - 1));
+    report[3] = 1 << (IFR1::BitPosition::VS - 1);
+    report[5] = static_cast<uint8_t>(-3);
+    report[6] = 2;
+    report[7] = static_cast<uint8_t>(IFR1::Mode::NAV2);
+
+    auto decoded = DeviceProfile::IFR1().Decode(report);
+    EXPECT_EQ(decoded.buttons, ButtonBit(IFR1::Button::ENT) | ButtonBit(IFR1::Button::INNER_KNOB) |
+                               ButtonBit(IFR1::Button::HDG) | ButtonBit(IFR1::Button::VS));
+    EXPECT_EQ(decoded.outerKnob, -3);
+    EXPECT_EQ(decoded.innerKnob, 2);
+    EXPECT_EQ(decoded.mode, static_cast<uint8_t>(IFR1::Mode::NAV2));
+
+    // Bits that carry no button decode to nothing
+    uint8_t idle[IFR1::HID_REPORT_SIZE] = {0, 0x0F, 0x3C, 0xF0, 0, 0, 0, 0, 0};
+    EXPECT_EQ(DeviceProfile::IFR1().Decode(idle).buttons, 0);
+}
+
+TEST(DeviceProfileTest, Compile_ExtractsMaskedFields) {
+    std::string error;
+    auto profile = DeviceProfile::Compile({
+        {"name", "Test Panel"},
+        {"vendor-id", 4660},
+        {"product-id", "0xABCD"},
+        {"report-size", 3},
+        {"buttons", {
+            {"ap", {{"byte", 0}, {"mask", 1}}},
+            {"alt", {{"byte", 0}, {"mask", 2}}}
+        }},
+        {"knobs", {{"inner-knob", {{"byte", 1}, {"mask", "0xF0"}}}}},
+        {"mode", {{"byte", 2}, {"mask", "0x0E"}}}
+    }, error);
+    ASSERT_TRUE(profile.has_value()) << error;
+    EXPECT_EQ(profile->GetName(), "Test Panel");
+    EXPECT_EQ(profile->GetVendorId(), 0x1234);
+    EXPECT_EQ(profile->GetProductId(), 0xABCD);
+    EXPECT_FALSE(profile->HasLEDs());
+    EXPECT_EQ(profile->GetMinReportLength(), 3u);
+
+    uint8_t report[3] = {0x02, 0xE5, 0x0B};
+    auto decoded = profile->Decode(report);
+    EXPECT_EQ(decoded.buttons, ButtonBit(IFR1::Button::ALT));
+    EXPECT_EQ(decoded.innerKnob, -2);  // 0xE in a 4-bit field
+    EXPECT_EQ(decoded.outerKnob, 0);
+    EXPECT_EQ(decoded.mode, 5);        // 0x0B & 0x0E = 0x0A, shifted by 1
+}
+
+TEST(DeviceProfileTest, Compile_RejectsInvalidProfiles) {
+    std::string error;
+    nlohmann::json base = {
+        {"vendor-id", 1},
+        {"product-id", 2},
+        {"report-size", 4},
+        {"buttons", {{"ap", {{"byte", 1}, {"mask", 1}}}}}
+    };
+    ASSERT_TRUE(DeviceProfile::Compile(base, error).has_value()) << error;
+
+    auto rejects = [&](nlohmann::json profile) {
+        std::string message;
+        bool rejected = !DeviceProfile::Compile(profile, message).has_value();
+        EXPECT_FALSE(message.empty());
+        return rejected;
+    };
+
+    auto missingVendor = base;
+    missingVendor.erase("vendor-id");
+    EXPECT_TRUE(rejects(missingVendor));
+
+    auto byteOutOfRange = base;
+    byteOutOfRange["buttons"]["ap"]["byte"] = 4;
+    EXPECT_TRUE(rejects(byteOutOfRange));
+
+    auto unknownButton = base;
+    unknownButton["buttons"]["turbo"] = {{"byte", 1}, {"mask", 2}};
+    EXPECT_TRUE(rejects(unknownButton));
+
+    auto splitKnob = base;
+    splitKnob["knobs"] = {{"outer-knob", {{"byte", 2}, {"mask", "0x05"}}}};
+    EXPECT_TRUE(rejects(splitKnob));
+
+    auto noFields = base;
+    noFields.erase("buttons");
+    EXPECT_TRUE(rejects(noFields));
+}
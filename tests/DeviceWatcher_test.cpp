@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "DeviceWatcher.h"
+#include <map>
+
+namespace {
+
+// Serials "attached" per vendor ID; product IDs are ignored
+struct FakeBus {
+    std::map<uint16_t, std::vector<std::string>> serials;
+
+    DeviceWatcher::Enumerator Enumerator() {
+        return [this](uint16_t vendorId, uint16_t) { return serials[vendorId]; };
+    }
+};
+
+} // namespace
+
+TEST(DeviceWatcherTest, ReportsUnitsAttachedAtStartup) {
+    FakeBus bus;
+    bus.serials[1] = {"A", "B"};
+    DeviceWatcher watcher({{1, 10}}, bus.Enumerator(), false);
+
+    auto first = watcher.TakeNewDevice();
+    auto second = watcher.TakeNewDevice();
+    ASSERT_TRUE(first && second);
+    EXPECT_EQ(first->serial, "A");
+    EXPECT_EQ(second->serial, "B");
+    EXPECT_EQ(first->target, 0u);
+    EXPECT_FALSE(watcher.TakeNewDevice().has_value());
+}
+
+TEST(DeviceWatcherTest, ReportsEachSerialOnceAcrossReplugs) {
+    FakeBus bus;
+    bus.serials[1] = {"A"};
+    DeviceWatcher watcher({{1, 10}}, bus.Enumerator(), false);
+    ASSERT_TRUE(watcher.TakeNewDevice().has_value());
+
+    // A second unit is plugged in later
+    bus.serials[1] = {"A", "B"};
+    watcher.Scan();
+    auto added = watcher.TakeNewDevice();
+    ASSERT_TRUE(added.has_value());
+    EXPECT_EQ(added->serial, "B");
+
+    // Unplugging and replugging a known unit leaves its existing context in charge
+    bus.serials[1] = {"B"};
+    watcher.Scan();
+    bus.serials[1] = {"A", "B"};
+    watcher.Scan();
+    EXPECT_FALSE(watcher.TakeNewDevice().has_value());
+}
+
+TEST(DeviceWatcherTest, TagsUnitsWithTheirTarget) {
+    FakeBus bus;
+    bus.serials[2] = {"X"};
+    DeviceWatcher watcher({{1, 10}, {2, 20}}, bus.Enumerator(), false);
+
+    auto found = watcher.TakeNewDevice();
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(found->target, 1u);
+    EXPECT_EQ(found->serial, "X");
+}
+
+TEST(DeviceWatcherTest, ThreadStopsPromptlyOnDestruction) {
+    FakeBus bus;
+    auto start = std::chrono::steady_clock::now();
+    {
+        DeviceWatcher watcher({{1, 10}}, bus.Enumerator());
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+}
@@ -25,6 +25,8 @@ public:
     MOCK_METHOD(int, GetDataiArray, (void* dataRef, int index), (override));
     MOCK_METHOD(void, SetDataiArray, (void* dataRef, int value, int index), (override));
     MOCK_METHOD(float, GetDatafArray, (void* dataRef, int index), (override));
+    MOCK_METHOD(int, GetDataiArrayRange, (void* dataRef, int* outValues, int offset, int count), (override));
+    MOCK_METHOD(int, GetDatafArrayRange, (void* dataRef, float* outValues, int offset, int count), (override));
     MOCK_METHOD(void, SetDatafArray, (void* dataRef, float value, int index), (override));
     MOCK_METHOD(int, GetDatab, (void* dataRef, void* outData, int offset, int maxLength), (override));
     MOCK_METHOD(void*, FindCommand, (const char* name), (override));
@@ -37,7 +39,8 @@ public:
     MOCK_METHOD(float, GetElapsedTime, (), (override));
     MOCK_METHOD(std::string, GetSystemPath, (), (override));
     MOCK_METHOD(bool, FileExists, (const std::string& path), (override));
-    MOCK_METHOD(void, PlaySound, (const std::string& path), (override));
+    MOCK_METHOD(SoundId, LoadSound, (const std::string& path), (override));
+    MOCK_METHOD(void, PlaySound, (SoundId sound), (override));
     MOCK_METHOD(void, DrawString, (const float color[4], int x, int y, const char* string), (override));
     MOCK_METHOD(void, DrawRectangle, (const float color[4], int l, int t, int r, int b), (override));
     MOCK_METHOD(void, DrawRectangleOutline, (const float color[4], int l, int t, int r, int b), (override));
@@ -566,7 +569,7 @@ TEST(EventProcessorTest, Command_SendCount_Negative) {
     processor.ProcessQueue();
 }
 
-TEST(EventProcessorTest, CommandQueueLimit_EnforcedAtTen) {
+TEST(EventProcessorTest, CommandQueueLimit_DropsBeyondCapacity) {
     NiceMock<MockXPlaneSDK> mockSdk;
     EventProcessor processor(mockSdk);
 
@@ -579,7 +582,7 @@ TEST(EventProcessorTest, CommandQueueLimit_EnforcedAtTen) {
                             {
                                 {"type", "command"},
                                 {"value", "sim/test/cmd"},
-                                {"send-count", 15}
+                                {"send-count", 70}
                             }
                         }}
                     }}
@@ -595,18 +598,17 @@ TEST(EventProcessorTest, CommandQueueLimit_EnforcedAtTen) {
     // Allow other log calls
     EXPECT_CALL(mockSdk, Log(::testing::_, ::testing::_)).WillRepeatedly(::testing::Return());
 
-    // We expect exactly 10 commands to be processed, even though we requested 15
-    EXPECT_CALL(mockSdk, CommandOnce(cmdRef)).Times(10);
-    
-    // We also expect a log message about discarding commands
-    EXPECT_CALL(mockSdk, Log(LogLevel::Verbose, ::testing::HasSubstr("Command queue full, discarding command"))).Times(5);
+    // Only the queue's capacity is kept, even though we requested 70
+    EXPECT_CALL(mockSdk, CommandOnce(cmdRef)).Times(CommandScheduler::kMaxPendingCommands);
+    EXPECT_CALL(mockSdk, Log(LogLevel::Verbose, ::testing::HasSubstr("Command queue full, discarding 6 command(s)"))).Times(1);
 
     processor.ProcessEvent(config, "com1", "button", "press");
-    
-    // Try to process 15 times, but only 10 should happen
-    for (int i = 0; i < 15; ++i) {
+    EXPECT_EQ(processor.GetCommandStats().dropped, 6u);
+
+    for (size_t i = 0; i < CommandScheduler::kMaxPendingCommands; ++i) {
         processor.ProcessQueue();
     }
+    EXPECT_EQ(processor.GetCommandStats().queueDepth, 0u);
 }
 
 TEST(EventProcessorTest, ProcessEvent_PlaysSound) {
@@ -631,7 +633,8 @@ TEST(EventProcessorTest, ProcessEvent_PlaysSound) {
     };
 
     EXPECT_CALL(mockSdk, GetSystemPath()).WillOnce(Return("/xplane/"));
-    EXPECT_CALL(mockSdk, PlaySound("/xplane/Resources/sounds/systems/click.wav")).Times(1);
+    EXPECT_CALL(mockSdk, LoadSound("/xplane/Resources/sounds/systems/click.wav")).WillOnce(Return(5));
+    EXPECT_CALL(mockSdk, PlaySound(5)).Times(1);
 
     processor.ProcessEvent(config, "fms1", "vnav", "short-press");
 }
@@ -669,8 +672,656 @@ TEST(EventProcessorTest, ProcessEvent_HandlesObjectWithActionsArray) {
 
     processor.ProcessEvent(config, "com1", "inner-knob", "rotate-clockwise");
     
+    // Both fit in one frame's command budget and run in order
+    ::testing::InSequence seq;
     EXPECT_CALL(sdk, CommandOnce(cmd1));
-    processor.ProcessQueue();
     EXPECT_CALL(sdk, CommandOnce(cmd2));
     processor.ProcessQueue();
 }
+
+TEST(EventProcessorTest, DataRefAdjust_CoalescedDetentsApplyInOneWrite) {
+    MockXPlaneSDK mockSdk;
+    EventProcessor processor(mockSdk);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"hdg", {
+                {"inner-knob", {
+                    {"rotate-clockwise", {
+                        {"actions", {
+                            {
+                                {"type", "dataref-adjust"},
+                                {"value", "sim/cockpit/autopilot/heading_mag"},
+                                {"adjustment", 1.0},
+                                {"min", 0.0},
+                                {"max", 359.0},
+                                {"limit-type", "wrap"}
+                            }
+                        }}
+                    }}
+                }}
+            }}
+        }}
+    };
+
+    void* dummyDr = reinterpret_cast<void*>(0x9ABC);
+    EXPECT_CALL(mockSdk, FindDataRef(StrEq("sim/cockpit/autopilot/heading_mag"))).WillOnce(Return(dummyDr));
+    EXPECT_CALL(mockSdk, GetDataRefTypes(dummyDr)).WillOnce(Return(2));
+    EXPECT_CALL(mockSdk, GetDataf(dummyDr)).WillOnce(Return(357.0f));
+    EXPECT_CALL(mockSdk, SetDataf(dummyDr, 2.0f)).Times(1);
+
+    processor.ProcessEvent(config, "hdg", "inner-knob", "rotate-clockwise", 5, 0.0f);
+}
+
+TEST(EventProcessorTest, DataRefAdjust_AccelerationCurveScalesFastTurns) {
+    MockXPlaneSDK mockSdk;
+    EventProcessor processor(mockSdk);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"ap", {
+                {"outer-knob", {
+                    {"rotate-clockwise", {
+                        {"actions", {
+                            {
+                                {"type", "dataref-adjust"},
+                                {"value", "sim/cockpit/autopilot/altitude"},
+                                {"adjustment", 100.0},
+                                {"acceleration", {
+                                    {{"velocity", 10.0}, {"multiplier", 5.0}},
+                                    {{"velocity", 20.0}, {"multiplier", 10.0}}
+                                }}
+                            }
+                        }}
+                    }}
+                }}
+            }}
+        }}
+    };
+
+    void* dummyDr = reinterpret_cast<void*>(0xDEF0);
+    EXPECT_CALL(mockSdk, FindDataRef(StrEq("sim/cockpit/autopilot/altitude"))).WillRepeatedly(Return(dummyDr));
+    EXPECT_CALL(mockSdk, GetDataRefTypes(dummyDr)).WillRepeatedly(Return(2));
+    EXPECT_CALL(mockSdk, GetDataf(dummyDr)).WillRepeatedly(Return(1000.0f));
+
+    // Below the first step: normal rate
+    EXPECT_CALL(mockSdk, SetDataf(dummyDr, 1200.0f));
+    processor.ProcessEvent(config, "ap", "outer-knob", "rotate-clockwise", 2, 5.0f);
+
+    // Between steps: first multiplier
+    EXPECT_CALL(mockSdk, SetDataf(dummyDr, 2000.0f));
+    processor.ProcessEvent(config, "ap", "outer-knob", "rotate-clockwise", 2, 15.0f);
+
+    // Past the last step: fastest multiplier
+    EXPECT_CALL(mockSdk, SetDataf(dummyDr, 3000.0f));
+    processor.ProcessEvent(config, "ap", "outer-knob", "rotate-clockwise", 2, 40.0f);
+}
+
+TEST(EventProcessorTest, Command_CountMultipliesSendCount) {
+    MockXPlaneSDK mockSdk;
+    EventProcessor processor(mockSdk);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"com1", {
+                {"inner-knob", {
+                    {"rotate-clockwise", {
+                        {"actions", {
+                            {{"type", "command"}, {"value", "sim/radios/stby_com1_fine_up"}}
+                        }}
+                    }}
+                }}
+            }}
+        }}
+    };
+
+    void* cmdRef = reinterpret_cast<void*>(0x123);
+    EXPECT_CALL(mockSdk, FindCommand(StrEq("sim/radios/stby_com1_fine_up"))).WillOnce(Return(cmdRef));
+    EXPECT_CALL(mockSdk, CommandOnce(cmdRef)).Times(3);
+
+    processor.ProcessEvent(config, "com1", "inner-knob", "rotate-clockwise", 3, 0.0f);
+    processor.ProcessQueue();
+    processor.ProcessQueue();
+    processor.ProcessQueue();
+    processor.ProcessQueue();
+}
+
+TEST(EventProcessorTest, PrepareConfig_ResolvesHandlesOnce) {
+    MockXPlaneSDK mockSdk;
+    EventProcessor processor(mockSdk);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"hdg", {
+                {"inner-knob", {
+                    {"rotate-clockwise", {
+                        {"actions", {
+                            {{"type", "dataref-adjust"}, {"value", "sim/cockpit/autopilot/heading_mag"}, {"adjustment", 1.0},
+                             {"min", 0.0}, {"max", 359.0}, {"limit-type", "wrap"}, {"continue-to-next-action", true}},
+                            {{"type", "command"}, {"value", "sim/autopilot/heading_sync"}}
+                        }}
+                    }}
+                }}
+            }}
+        }}
+    };
+
+    void* dummyDr = reinterpret_cast<void*>(0x5678);
+    void* dummyCmd = reinterpret_cast<void*>(0x1234);
+    EXPECT_CALL(mockSdk, FindDataRef(StrEq("sim/cockpit/autopilot/heading_mag"))).WillOnce(Return(dummyDr));
+    EXPECT_CALL(mockSdk, GetDataRefTypes(dummyDr)).WillOnce(Return(2));
+    EXPECT_CALL(mockSdk, FindCommand(StrEq("sim/autopilot/heading_sync"))).WillOnce(Return(dummyCmd));
+    processor.PrepareConfig(config);
+
+    // Running the event needs no further lookups
+    EXPECT_CALL(mockSdk, GetDataf(dummyDr)).WillOnce(Return(359.0f)).WillOnce(Return(0.0f));
+    EXPECT_CALL(mockSdk, SetDataf(dummyDr, 0.0f));
+    EXPECT_CALL(mockSdk, SetDataf(dummyDr, 1.0f));
+    EXPECT_CALL(mockSdk, CommandOnce(dummyCmd)).Times(2);
+    processor.ProcessEvent(config, "hdg", "inner-knob", "rotate-clockwise");
+    processor.ProcessEvent(config, "hdg", "inner-knob", "rotate-clockwise");
+    processor.ProcessQueue();
+    processor.ProcessQueue();
+}
+
+TEST(EventProcessorTest, PrepareConfig_RetriesMissingHandleWhenUsed) {
+    MockXPlaneSDK mockSdk;
+    EventProcessor processor(mockSdk);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"ap", {
+                {"ap", {
+                    {"short-press", {
+                        {"actions", {
+                            {{"type", "command"}, {"value", "thirdparty/ap/toggle"}}
+                        }}
+                    }}
+                }}
+            }}
+        }}
+    };
+
+    // The aircraft plugin registers its command after the config is prepared
+    void* cmdRef = reinterpret_cast<void*>(0x4321);
+    EXPECT_CALL(mockSdk, FindCommand(StrEq("thirdparty/ap/toggle")))
+        .WillOnce(Return(nullptr))
+        .WillOnce(Return(cmdRef));
+    processor.PrepareConfig(config);
+
+    EXPECT_CALL(mockSdk, CommandOnce(cmdRef)).Times(2);
+    processor.ProcessEvent(config, "ap", "ap", "short-press");
+    processor.ProcessEvent(config, "ap", "ap", "short-press");
+    processor.ProcessQueue();
+    processor.ProcessQueue();
+}
+
+TEST(EventProcessorTest, PrepareConfig_DispatchesByEventIds) {
+    MockXPlaneSDK mockSdk;
+    EventProcessor processor(mockSdk);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"baro", {
+                {"inner-knob", {
+                    {"rotate-counterclockwise", {
+                        {"actions", {
+                            {{"type", "command"}, {"value", "sim/instruments/barometer_down"}}
+                        }}
+                    }}
+                }}
+            }},
+            {"custom-mode", {
+                {"swap", {
+                    {"short-press", {
+                        {"actions", {
+                            {{"type", "command"}, {"value", "sim/never/used"}}
+                        }}
+                    }}
+                }}
+            }}
+        }}
+    };
+
+    // Names that no control can produce are not compiled
+    void* cmdRef = reinterpret_cast<void*>(0x99);
+    EXPECT_CALL(mockSdk, FindCommand(StrEq("sim/instruments/barometer_down"))).WillOnce(Return(cmdRef));
+    EXPECT_CALL(mockSdk, FindCommand(StrEq("sim/never/used"))).Times(0);
+    processor.PrepareConfig(config);
+
+    // "baro" is COM2 in the shifted state
+    EXPECT_CALL(mockSdk, CommandOnce(cmdRef)).Times(1);
+    processor.ProcessEvent(config, EventId::ModeOf(IFR1::Mode::COM2, true), EventId::Control::INNER_KNOB,
+                           EventId::Action::ROTATE_COUNTERCLOCKWISE);
+    processor.ProcessEvent(config, EventId::ModeOf(IFR1::Mode::COM2, false), EventId::Control::INNER_KNOB,
+                           EventId::Action::ROTATE_COUNTERCLOCKWISE);
+    processor.ProcessQueue();
+    processor.ProcessQueue();
+}
+
+TEST(EventProcessorTest, ProcessQueue_ButtonPressRunsBeforeQueuedKnobTicks) {
+    NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor processor(mockSdk);
+
+    nlohmann::json config = {
+        {"command-scheduler", {{"commands-per-frame", 1}}},
+        {"modes", {
+            {"com1", {
+                {"inner-knob", {
+                    {"rotate-clockwise", {
+                        {"actions", {{{"type", "command"}, {"value", "sim/radios/stby_com1_fine_up"}}}}
+                    }}
+                }},
+                {"swap", {
+                    {"short-press", {
+                        {"actions", {{{"type", "command"}, {"value", "sim/radios/com1_standy_flip"}}}}
+                    }}
+                }}
+            }}
+        }}
+    };
+
+    void* tickCmd = reinterpret_cast<void*>(0x1);
+    void* swapCmd = reinterpret_cast<void*>(0x2);
+    ON_CALL(mockSdk, FindCommand(StrEq("sim/radios/stby_com1_fine_up"))).WillByDefault(Return(tickCmd));
+    ON_CALL(mockSdk, FindCommand(StrEq("sim/radios/com1_standy_flip"))).WillByDefault(Return(swapCmd));
+    processor.PrepareConfig(config);
+
+    processor.ProcessEvent(config, "com1", "inner-knob", "rotate-clockwise", 3);
+    processor.ProcessQueue();
+    processor.ProcessEvent(config, "com1", "swap", "short-press");
+
+    ::testing::InSequence seq;
+    EXPECT_CALL(mockSdk, CommandOnce(swapCmd));
+    EXPECT_CALL(mockSdk, CommandOnce(tickCmd)).Times(2);
+    processor.ProcessQueue();
+    processor.ProcessQueue();
+    processor.ProcessQueue();
+}
+
+TEST(EventProcessorTest, SharedDataRefRegistry_LooksUpEachDataRefOnce) {
+    MockXPlaneSDK mockSdk;
+    DataRefRegistry dataRefs(mockSdk);
+    EventProcessor first(mockSdk, dataRefs);
+    EventProcessor second(mockSdk, dataRefs);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"hdg", {
+                {"inner-knob", {
+                    {"rotate-clockwise", {
+                        {"actions", {
+                            {{"type", "dataref-adjust"}, {"value", "sim/cockpit/autopilot/heading_mag"}, {"adjustment", 1.0},
+                             {"condition", {{"dataref", "sim/cockpit/autopilot/heading_mag"}, {"min", 0.0}, {"max", 90.0}}}}
+                        }}
+                    }}
+                }}
+            }}
+        }}
+    };
+
+    // Two devices, one action and one condition: still a single lookup
+    void* dummyDr = reinterpret_cast<void*>(0x5678);
+    EXPECT_CALL(mockSdk, FindDataRef(StrEq("sim/cockpit/autopilot/heading_mag"))).WillOnce(Return(dummyDr));
+    EXPECT_CALL(mockSdk, GetDataRefTypes(dummyDr)).WillOnce(Return(2));
+    first.PrepareConfig(config);
+    second.PrepareConfig(config);
+
+    EXPECT_CALL(mockSdk, GetDataf(dummyDr)).WillRepeatedly(Return(10.0f));
+    EXPECT_CALL(mockSdk, SetDataf(dummyDr, 11.0f)).Times(2);
+    first.ProcessEvent(config, "hdg", "inner-knob", "rotate-clockwise");
+    second.ProcessEvent(config, "hdg", "inner-knob", "rotate-clockwise");
+}
+
+TEST(EventProcessorTest, DataRefAdjust_CoalescesWritesWithinFrame) {
+    MockXPlaneSDK mockSdk;
+    DataRefRegistry dataRefs(mockSdk);
+    EventProcessor processor(mockSdk, dataRefs);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"hdg", {
+                {"inner-knob", {
+                    {"rotate-clockwise", {
+                        {"actions", {
+                            {{"type", "dataref-adjust"}, {"value", "sim/cockpit/autopilot/heading_mag"}, {"adjustment", 1.0},
+                             {"continue-to-next-action", true}},
+                            {{"type", "command"}, {"value", "sim/autopilot/heading_sync"},
+                             {"condition", {{"dataref", "sim/cockpit/autopilot/heading_mag"}, {"eq", 12}}}}
+                        }}
+                    }}
+                }}
+            }}
+        }}
+    };
+
+    void* dummyDr = reinterpret_cast<void*>(0x5678);
+    void* syncCmd = reinterpret_cast<void*>(0x9);
+    EXPECT_CALL(mockSdk, FindDataRef(StrEq("sim/cockpit/autopilot/heading_mag"))).WillOnce(Return(dummyDr));
+    EXPECT_CALL(mockSdk, GetDataRefTypes(dummyDr)).WillOnce(Return(2));
+    EXPECT_CALL(mockSdk, FindCommand(StrEq("sim/autopilot/heading_sync"))).WillOnce(Return(syncCmd));
+    processor.PrepareConfig(config);
+
+    // One read and one write for the frame; the condition sees the held value
+    EXPECT_CALL(mockSdk, GetDataf(dummyDr)).WillOnce(Return(10.0f));
+    EXPECT_CALL(mockSdk, SetDataf(dummyDr, ::testing::_)).Times(0);
+    dataRefs.BeginFrame();
+    processor.ProcessEvent(config, "hdg", "inner-knob", "rotate-clockwise");
+    processor.ProcessEvent(config, "hdg", "inner-knob", "rotate-clockwise");
+    EXPECT_EQ(dataRefs.GetPendingWriteCount(), 1u);
+    EXPECT_EQ(processor.GetCommandStats().queueDepth, 1u);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+
+    {
+        ::testing::InSequence inOrder;
+        EXPECT_CALL(mockSdk, SetDataf(dummyDr, 12.0f));
+        EXPECT_CALL(mockSdk, CommandOnce(syncCmd));
+    }
+    processor.ProcessQueue();
+    EXPECT_EQ(dataRefs.GetPendingWriteCount(), 0u);
+    dataRefs.EndFrame();
+}
+
+TEST(EventProcessorTest, Sequence_RunsStepsAcrossFramesWithWaits) {
+    NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor processor(mockSdk);
+    float now = 10.0f;
+    ON_CALL(mockSdk, GetElapsedTime()).WillByDefault([&]() { return now; });
+
+    nlohmann::json config = {
+        {"modes", {
+            {"ap", {
+                {"ap", {
+                    {"short-press", {
+                        {"actions", {{
+                            {"type", "sequence"},
+                            {"steps", {
+                                {{"type", "command"}, {"value", "sim/autopilot/servos_on"}},
+                                {{"wait-ms", 150}},
+                                {{"wait-until", {{"dataref", "sim/cockpit2/autopilot/servos_on"}, {"eq", 1}}}},
+                                {{"type", "command"}, {"value", "sim/autopilot/heading"}}
+                            }}
+                        }}}
+                    }}
+                }}
+            }}
+        }}
+    };
+
+    void* servosCmd = reinterpret_cast<void*>(0x1);
+    void* headingCmd = reinterpret_cast<void*>(0x2);
+    void* servosDr = reinterpret_cast<void*>(0x3);
+    int servosOn = 0;
+    ON_CALL(mockSdk, FindCommand(StrEq("sim/autopilot/servos_on"))).WillByDefault(Return(servosCmd));
+    ON_CALL(mockSdk, FindCommand(StrEq("sim/autopilot/heading"))).WillByDefault(Return(headingCmd));
+    ON_CALL(mockSdk, FindDataRef(StrEq("sim/cockpit2/autopilot/servos_on"))).WillByDefault(Return(servosDr));
+    ON_CALL(mockSdk, GetDataRefTypes(servosDr)).WillByDefault(Return(1));
+    ON_CALL(mockSdk, GetDatai(servosDr)).WillByDefault([&]() { return servosOn; });
+    processor.PrepareConfig(config);
+
+    EXPECT_CALL(mockSdk, CommandOnce(servosCmd)).Times(1);
+    EXPECT_CALL(mockSdk, CommandOnce(headingCmd)).Times(0);
+    processor.ProcessEvent(config, "ap", "ap", "short-press");
+    processor.ProcessQueue();
+    now = 10.1f;
+    processor.ProcessQueue();
+    now = 10.2f;   // Wait is over; now waiting for the servos
+    processor.ProcessQueue();
+    EXPECT_EQ(processor.GetActiveSequenceCount(), 1u);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+
+    EXPECT_CALL(mockSdk, CommandOnce(headingCmd)).Times(1);
+    servosOn = 1;
+    now = 10.3f;
+    processor.ProcessQueue();
+    EXPECT_EQ(processor.GetActiveSequenceCount(), 0u);
+}
+
+TEST(EventProcessorTest, Sequence_CancelAndTimeoutStopRemainingSteps) {
+    NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor processor(mockSdk);
+    float now = 0.0f;
+    ON_CALL(mockSdk, GetElapsedTime()).WillByDefault([&]() { return now; });
+
+    nlohmann::json config = {
+        {"modes", {
+            {"com1", {
+                {"swap", {
+                    {"short-press", {
+                        {"actions", {{
+                            {"type", "sequence"},
+                            {"steps", {
+                                {{"wait-ms", 500}},
+                                {{"type", "command"}, {"value", "sim/radios/com1_standy_flip"}}
+                            }}
+                        }}}
+                    }}
+                }},
+                {"ap", {
+                    {"short-press", {
+                        {"actions", {{
+                            {"type", "sequence"},
+                            {"steps", {
+                                {{"wait-until", {{"dataref", "sim/cockpit2/autopilot/servos_on"}, {"eq", 1}}}, {"timeout-ms", 1000}},
+                                {{"type", "command"}, {"value", "sim/radios/com1_standy_flip"}}
+                            }}
+                        }}}
+                    }}
+                }}
+            }}
+        }}
+    };
+
+    void* flipCmd = reinterpret_cast<void*>(0x1);
+    void* servosDr = reinterpret_cast<void*>(0x3);
+    ON_CALL(mockSdk, FindCommand(StrEq("sim/radios/com1_standy_flip"))).WillByDefault(Return(flipCmd));
+    ON_CALL(mockSdk, FindDataRef(StrEq("sim/cockpit2/autopilot/servos_on"))).WillByDefault(Return(servosDr));
+    ON_CALL(mockSdk, GetDataRefTypes(servosDr)).WillByDefault(Return(1));
+    ON_CALL(mockSdk, GetDatai(servosDr)).WillByDefault(Return(0));
+    processor.PrepareConfig(config);
+
+    EXPECT_CALL(mockSdk, CommandOnce(flipCmd)).Times(0);
+
+    // Turning the mode selector cancels the wait
+    processor.ProcessEvent(config, "com1", "swap", "short-press");
+    processor.ProcessQueue();
+    ASSERT_EQ(processor.GetActiveSequenceCount(), 1u);
+    processor.CancelSequences();
+    now = 1.0f;
+    processor.ProcessQueue();
+
+    // A wait-until that times out ends the sequence
+    processor.ProcessEvent(config, "com1", "ap", "short-press");
+    processor.ProcessQueue();
+    ASSERT_EQ(processor.GetActiveSequenceCount(), 1u);
+    now = 2.5f;
+    processor.ProcessQueue();
+    EXPECT_EQ(processor.GetActiveSequenceCount(), 0u);
+}
+
+TEST(EventProcessorTest, Hold_BeginsOnPressAndEndsOnRelease) {
+    NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor processor(mockSdk);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"com1", {
+                {"swap", {{"press", {{"actions", {{{"type", "hold"}, {"value", "sim/radios/transmit"}}}}}}}},
+                {"menu", {{"short-press", {{"actions", {{{"type", "hold"}, {"value", "sim/radios/transmit"}}}}}}}}
+            }}
+        }}
+    };
+    void* transmitCmd = reinterpret_cast<void*>(0x1);
+    ON_CALL(mockSdk, FindCommand(StrEq("sim/radios/transmit"))).WillByDefault(Return(transmitCmd));
+    processor.PrepareConfig(config);
+
+    EXPECT_CALL(mockSdk, CommandBegin(transmitCmd)).Times(1);
+    EXPECT_CALL(mockSdk, CommandEnd(transmitCmd)).Times(0);
+    processor.ProcessEvent(config, "com1", "swap", "press");
+    processor.ProcessQueue();
+    processor.ReleaseControl(EventId::Control::MENU);   // Another button does not end it
+    EXPECT_EQ(processor.GetActiveHoldCount(), 1u);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+
+    EXPECT_CALL(mockSdk, CommandEnd(transmitCmd)).Times(1);
+    processor.ReleaseControl(EventId::Control::SWAP);
+    EXPECT_EQ(processor.GetActiveHoldCount(), 0u);
+    ::testing::Mock::VerifyAndClearExpectations(&mockSdk);
+
+    // Without a press to wait for, a hold sends the command once
+    EXPECT_CALL(mockSdk, CommandBegin(::testing::_)).Times(0);
+    EXPECT_CALL(mockSdk, CommandOnce(transmitCmd)).Times(1);
+    processor.ProcessEvent(config, "com1", "menu", "short-press");
+    processor.ProcessQueue();
+    EXPECT_EQ(processor.GetActiveHoldCount(), 0u);
+}
+
+TEST(EventProcessorTest, Repeat_FiresAtRateUntilRelease) {
+    NiceMock<MockXPlaneSDK> mockSdk;
+    EventProcessor processor(mockSdk);
+    float now = 0.0f;
+    ON_CALL(mockSdk, GetElapsedTime()).WillByDefault([&]() { return now; });
+
+    nlohmann::json config = {
+        {"modes", {
+            {"fms1", {
+                {"clr", {{"press", {{"actions", {{
+                    {"type", "repeat"},
+                    {"rate-hz", 10},
+                    {"delay-ms", 400},
+                    {"action", {{"type", "command"}, {"value", "sim/GPS/g1000n1_clr"}}}
+                }}}}}}}
+            }}
+        }}
+    };
+    void* clrCmd = reinterpret_cast<void*>(0x1);
+    ON_CALL(mockSdk, FindCommand(StrEq("sim/GPS/g1000n1_clr"))).WillByDefault(Return(clrCmd));
+    processor.PrepareConfig(config);
+
+    int sent = 0;
+    ON_CALL(mockSdk, CommandOnce(clrCmd)).WillByDefault([&](void*) { ++sent; });
+
+    processor.ProcessEvent(config, "fms1", "clr", "press");
+    processor.ProcessQueue();
+    EXPECT_EQ(sent, 1);
+
+    // Nothing more until the delay has passed, then one per 100 ms
+    for (float t : {0.1f, 0.2f, 0.39f}) {
+        now = t;
+        processor.ProcessQueue();
+    }
+    EXPECT_EQ(sent, 1);
+    for (float t : {0.45f, 0.57f, 0.69f}) {
+        now = t;
+        processor.ProcessQueue();
+    }
+    EXPECT_EQ(sent, 4);
+
+    processor.ReleaseControl(EventId::Control::CLR);
+    EXPECT_EQ(processor.GetActiveHoldCount(), 0u);
+    for (float t : {0.8f, 0.9f, 1.5f}) {
+        now = t;
+        processor.ProcessQueue();
+    }
+    EXPECT_EQ(sent, 4);
+}
+
+TEST(EventProcessorTest, PrepareConfig_ReadsConditionArrayElementsWithOneRangedCall) {
+    NiceMock<MockXPlaneSDK> mockSdk;
+    DataRefRegistry dataRefs(mockSdk);
+    EventProcessor processor(mockSdk, dataRefs);
+
+    // The first action is skipped, so the second reads elements 0 and 2 too
+    nlohmann::json config = {
+        {"modes", {
+            {"ap", {
+                {"ap", {
+                    {"short-press", {
+                        {"actions", {
+                            {{"type", "command"}, {"value", "sim/test/first"},
+                             {"condition", {{"dataref", "sim/test/bus[0]"}, {"eq", 0}}}},
+                            {{"type", "command"}, {"value", "sim/test/second"},
+                             {"conditions", {{{"dataref", "sim/test/bus[1]"}, {"eq", 0}},
+                                             {{"dataref", "sim/test/bus[2]"}, {"eq", 1}}}}}
+                        }}
+                    }}
+                }}
+            }}
+        }}
+    };
+
+    void* busDr = reinterpret_cast<void*>(0x1);
+    void* secondCmd = reinterpret_cast<void*>(0x2);
+    ON_CALL(mockSdk, FindDataRef(StrEq("sim/test/bus"))).WillByDefault(Return(busDr));
+    ON_CALL(mockSdk, GetDataRefTypes(busDr)).WillByDefault(Return(16)); // xplmType_IntArray = 16
+    ON_CALL(mockSdk, FindCommand(StrEq("sim/test/first"))).WillByDefault(Return(reinterpret_cast<void*>(0x3)));
+    ON_CALL(mockSdk, FindCommand(StrEq("sim/test/second"))).WillByDefault(Return(secondCmd));
+    processor.PrepareConfig(config);
+
+    EXPECT_CALL(mockSdk, GetDataiArrayRange(busDr, ::testing::_, 0, 3))
+        .WillOnce([](void*, int* out, int, int count) {
+            for (int i = 0; i < count; ++i) out[i] = (i == 1) ? 0 : 1;
+            return count;
+        });
+    EXPECT_CALL(mockSdk, GetDataiArray(::testing::_, ::testing::_)).Times(0);
+    EXPECT_CALL(mockSdk, CommandOnce(secondCmd)).Times(1);
+    dataRefs.BeginFrame();
+    processor.ProcessEvent(config, "ap", "ap", "short-press");
+    processor.ProcessQueue();
+    dataRefs.EndFrame();
+}
+
+TEST(EventProcessorTest, Sequence_ReadsWaitUntilArrayElementsWithOneRangedCall) {
+    NiceMock<MockXPlaneSDK> mockSdk;
+    DataRefRegistry dataRefs(mockSdk);
+    EventProcessor processor(mockSdk, dataRefs);
+
+    nlohmann::json config = {
+        {"modes", {
+            {"ap", {
+                {"ap", {
+                    {"short-press", {
+                        {"actions", {{
+                            {"type", "sequence"},
+                            {"steps", {
+                                {{"wait-until", {{"all", {{{"dataref", "sim/test/bus[0]"}, {"eq", 1}},
+                                                          {{"dataref", "sim/test/bus[1]"}, {"eq", 1}}}}}}},
+                                {{"type", "command"}, {"value", "sim/test/done"}}
+                            }}
+                        }}}
+                    }}
+                }}
+            }}
+        }}
+    };
+
+    void* busDr = reinterpret_cast<void*>(0x1);
+    void* doneCmd = reinterpret_cast<void*>(0x2);
+    int bus = 0;
+    ON_CALL(mockSdk, FindDataRef(StrEq("sim/test/bus"))).WillByDefault(Return(busDr));
+    ON_CALL(mockSdk, GetDataRefTypes(busDr)).WillByDefault(Return(16)); // xplmType_IntArray = 16
+    ON_CALL(mockSdk, FindCommand(StrEq("sim/test/done"))).WillByDefault(Return(doneCmd));
+    processor.PrepareConfig(config);
+
+    // One ranged read per frame while the sequence waits
+    EXPECT_CALL(mockSdk, GetDataiArrayRange(busDr, ::testing::_, 0, 2))
+        .Times(2)
+        .WillRepeatedly([&](void*, int* out, int, int count) {
+            for (int i = 0; i < count; ++i) out[i] = bus;
+            return count;
+        });
+    EXPECT_CALL(mockSdk, GetDataiArray(::testing::_, ::testing::_)).Times(0);
+    EXPECT_CALL(mockSdk, CommandOnce(doneCmd)).Times(1);
+
+    dataRefs.BeginFrame();
+    processor.ProcessEvent(config, "ap", "ap", "short-press");
+    processor.ProcessQueue();
+    dataRefs.EndFrame();
+    EXPECT_EQ(processor.GetActiveSequenceCount(), 1u);
+
+    bus = 1;
+    dataRefs.BeginFrame();
+    processor.ProcessQueue();
+    dataRefs.EndFrame();
+    EXPECT_EQ(processor.GetActiveSequenceCount(), 0u);
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "HIDManager.h"
+#include <chrono>
+#include <thread>
+
+TEST(HIDManagerTest, IdleWaitBlocksInLongSlices) {
+    std::atomic<bool> wake{false};
+    int reads = 0;
+    std::thread waker([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        wake = true;
+    });
+
+    // hid_read_timeout blocks for the whole slice when no report arrives
+    const int result = HIDManager::WaitInSlices(wake, -1, [&](int sliceMs) {
+        ++reads;
+        EXPECT_EQ(sliceMs, HIDManager::kWaitSliceMs);
+        std::this_thread::sleep_for(std::chrono::milliseconds(sliceMs));
+        return 0;
+    });
+    waker.join();
+
+    EXPECT_EQ(result, 0);
+    EXPECT_GE(HIDManager::kWaitSliceMs, 20);
+    EXPECT_LE(reads, 200 / HIDManager::kWaitSliceMs + 2);
+}
+
+TEST(HIDManagerTest, WaitEndsOnReportOrDeadline) {
+    std::atomic<bool> wake{false};
+    int reads = 0;
+    EXPECT_EQ(HIDManager::WaitInSlices(wake, -1, [&](int) { return ++reads == 3 ? 9 : 0; }), 9);
+    EXPECT_EQ(reads, 3);
+
+    // A short deadline shortens the slice rather than overshooting it
+    EXPECT_EQ(HIDManager::WaitInSlices(wake, 5, [&](int sliceMs) {
+        EXPECT_LE(sliceMs, 5);
+        std::this_thread::sleep_for(std::chrono::milliseconds(sliceMs));
+        return 0;
+    }), 0);
+
+    // A pending wake ends the wait before any read
+    reads = 0;
+    wake = true;
+    EXPECT_EQ(HIDManager::WaitInSlices(wake, -1, [&](int) { return ++reads; }), 0);
+    EXPECT_EQ(reads, 0);
+    EXPECT_FALSE(wake);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "HidrawManager.h"
+#include "IFR1Protocol.h"
+#include <chrono>
+
+TEST(HidrawManagerTest, ParseHidUevent_ReadsVendorAndProduct) {
+    std::string uevent =
+        "DRIVER=hid-generic\n"
+        "HID_ID=0003:000004D8:0000E6D6\n"
+        "HID_NAME=Octavi IFR1\n";
+
+    auto info = ParseHidUevent(uevent);
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->vendorId, 0x04D8);
+    EXPECT_EQ(info->productId, 0xE6D6);
+    EXPECT_TRUE(info->serial.empty());
+}
+
+TEST(HidrawManagerTest, ParseHidUevent_ReadsSerialNumber) {
+    std::string uevent =
+        "DRIVER=hid-generic\n"
+        "HID_UNIQ=IFR1-000123\n"
+        "HID_ID=0003:000004D8:0000E6D6\n";
+
+    auto info = ParseHidUevent(uevent);
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->serial, "IFR1-000123");
+}
+
+TEST(HidrawManagerTest, ParseHidUevent_RejectsMissingOrMalformedId) {
+    EXPECT_FALSE(ParseHidUevent("DRIVER=hid-generic\nHID_NAME=Keyboard\n").has_value());
+    EXPECT_FALSE(ParseHidUevent("HID_ID=garbage\n").has_value());
+    EXPECT_FALSE(ParseHidUevent("").has_value());
+}
+
+TEST(HidrawManagerTest, IOFailsWhenNotConnected) {
+    HidrawManager manager;
+    uint8_t buffer[9]{};
+
+    EXPECT_FALSE(manager.IsConnected());
+    EXPECT_EQ(manager.Read(buffer, sizeof(buffer), 0), -1);
+    EXPECT_EQ(manager.Write(buffer, 2), -1);
+}
+
+TEST(HidrawManagerTest, WakeInterruptsWaitForInput) {
+    HidrawManager manager;
+    ASSERT_TRUE(manager.CanWaitForInput());
+
+    manager.Wake();
+    auto start = std::chrono::steady_clock::now();
+    manager.WaitForInput(5000);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+    // The wake is consumed, so a second wait runs to its timeout
+    start = std::chrono::steady_clock::now();
+    manager.WaitForInput(50);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(40));
+}
+
+TEST(HidrawManagerTest, OnlyShutdownInterruptsWaitForDevice) {
+    HidrawManager manager;
+    if (!manager.SupportsHotplug()) {
+        GTEST_SKIP() << "udev netlink monitor not available in this environment";
+    }
+    manager.Connect(IFR1::VENDOR_ID, IFR1::PRODUCT_ID);
+    manager.Disconnect();
+
+    // LED wakes are for the input wait and must not cut a device wait short
+    manager.Wake();
+    auto start = std::chrono::steady_clock::now();
+    manager.WaitForDevice(50);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(40));
+
+    manager.Shutdown();
+    start = std::chrono::steady_clock::now();
+    manager.WaitForDevice(5000);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+}
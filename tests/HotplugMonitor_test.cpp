@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+#include "HotplugMonitor.h"
+#include "IFR1Protocol.h"
+#include <chrono>
+
+TEST(HotplugMonitorTest, WaitReturnsFalseWhenUnavailable) {
+    HotplugMonitor monitor;
+    if (monitor.IsAvailable()) {
+        GTEST_SKIP() << "udev is available; covered by the wake/timeout tests";
+    }
+    EXPECT_FALSE(monitor.WaitForDevice(IFR1::VENDOR_ID, IFR1::PRODUCT_ID, 1000));
+}
+
+TEST(HotplugMonitorTest, WakeInterruptsWait) {
+    HotplugMonitor monitor;
+    if (!monitor.IsAvailable()) {
+        GTEST_SKIP() << "udev netlink monitor not available in this environment";
+    }
+
+    monitor.Wake();
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(monitor.WaitForDevice(IFR1::VENDOR_ID, IFR1::PRODUCT_ID, 5000));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+}
+
+TEST(HotplugMonitorTest, WaitTimesOutWithoutMatchingDevice) {
+    HotplugMonitor monitor;
+    if (!monitor.IsAvailable()) {
+        GTEST_SKIP() << "udev netlink monitor not available in this environment";
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(monitor.WaitForDevice(IFR1::VENDOR_ID, IFR1::PRODUCT_ID, 50));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(40));
+}
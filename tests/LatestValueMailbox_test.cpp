@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "LatestValueMailbox.h"
+#include <algorithm>
+#include <array>
+#include <thread>
+
+TEST(LatestValueMailboxTest, TakeReturnsOnlyTheNewestValueOnce) {
+    LatestValueMailbox<int> mailbox;
+    EXPECT_FALSE(mailbox.HasNew());
+    EXPECT_FALSE(mailbox.Take().has_value());
+
+    mailbox.Publish(1);
+    mailbox.Publish(2);
+    mailbox.Publish(3);
+    EXPECT_TRUE(mailbox.HasNew());
+    EXPECT_EQ(mailbox.GetGeneration(), 3u);
+    EXPECT_EQ(mailbox.Take(), 3);
+    EXPECT_FALSE(mailbox.Take().has_value());
+
+    mailbox.Publish(4);
+    mailbox.Discard();
+    EXPECT_FALSE(mailbox.HasNew());
+    EXPECT_FALSE(mailbox.Take().has_value());
+
+    mailbox.Publish(5);
+    EXPECT_EQ(mailbox.Take(), 5);
+}
+
+TEST(LatestValueMailboxTest, ConsumerSeesIncreasingValuesAndTheLast) {
+    LatestValueMailbox<std::array<int, 8>> mailbox;
+    const int count = 100000;
+
+    std::thread producer([&mailbox, count]() {
+        for (int i = 1; i <= count; ++i) {
+            std::array<int, 8> value;
+            value.fill(i);
+            mailbox.Publish(value);
+        }
+    });
+
+    // Every value taken must be whole and newer than the one before
+    int last = 0;
+    bool consistent = true;
+    while (last < count) {
+        if (auto value = mailbox.Take()) {
+            consistent = consistent && (*value)[0] > last &&
+                         std::all_of(value->begin(), value->end(), [&](int v) { return v == (*value)[0]; });
+            last = (*value)[0];
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(consistent);
+    EXPECT_FALSE(mailbox.HasNew());
+}
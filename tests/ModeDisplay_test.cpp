@@ -33,6 +33,8 @@ public:
     MOCK_METHOD(int, GetDataiArray, (void* dataRef, int index), (override));
     MOCK_METHOD(void, SetDataiArray, (void* dataRef, int value, int index), (override));
     MOCK_METHOD(float, GetDatafArray, (void* dataRef, int index), (override));
+    MOCK_METHOD(int, GetDataiArrayRange, (void* dataRef, int* outValues, int offset, int count), (override));
+    MOCK_METHOD(int, GetDatafArrayRange, (void* dataRef, float* outValues, int offset, int count), (override));
     MOCK_METHOD(void, SetDatafArray, (void* dataRef, float value, int index), (override));
     MOCK_METHOD(int, GetDatab, (void* dataRef, void* outData, int offset, int maxLength), (override));
     MOCK_METHOD(void*, FindCommand, (const char* name), (override));
@@ -45,7 +47,8 @@ public:
     MOCK_METHOD(float, GetElapsedTime, (), (override));
     MOCK_METHOD(std::string, GetSystemPath, (), (override));
     MOCK_METHOD(bool, FileExists, (const std::string& path), (override));
-    MOCK_METHOD(void, PlaySound, (const std::string& path), (override));
+    MOCK_METHOD(SoundId, LoadSound, (const std::string& path), (override));
+    MOCK_METHOD(void, PlaySound, (SoundId sound), (override));
     MOCK_METHOD(void, DrawString, (const float color[4], int x, int y, const char* string), (override));
     MOCK_METHOD(void, DrawRectangle, (const float color[4], int l, int t, int r, int b), (override));
     MOCK_METHOD(void, DrawRectangleOutline, (const float color[4], int l, int t, int r, int b), (override));
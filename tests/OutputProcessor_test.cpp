@@ -21,6 +21,8 @@ public:
     MOCK_METHOD(int, GetDataiArray, (void* dataRef, int index), (override));
     MOCK_METHOD(void, SetDataiArray, (void* dataRef, int value, int index), (override));
     MOCK_METHOD(float, GetDatafArray, (void* dataRef, int index), (override));
+    MOCK_METHOD(int, GetDataiArrayRange, (void* dataRef, int* outValues, int offset, int count), (override));
+    MOCK_METHOD(int, GetDatafArrayRange, (void* dataRef, float* outValues, int offset, int count), (override));
     MOCK_METHOD(void, SetDatafArray, (void* dataRef, float value, int index), (override));
     MOCK_METHOD(int, GetDatab, (void* dataRef, void* outData, int offset, int maxLength), (override));
     MOCK_METHOD(void*, FindCommand, (const char* name), (override));
@@ -33,7 +35,8 @@ public:
     MOCK_METHOD(float, GetElapsedTime, (), (override));
     MOCK_METHOD(std::string, GetSystemPath, (), (override));
     MOCK_METHOD(bool, FileExists, (const std::string& path), (override));
-    MOCK_METHOD(void, PlaySound, (const std::string& path), (override));
+    MOCK_METHOD(SoundId, LoadSound, (const std::string& path), (override));
+    MOCK_METHOD(void, PlaySound, (SoundId sound), (override));
     MOCK_METHOD(void, DrawString, (const float color[4], int x, int y, const char* string), (override));
     MOCK_METHOD(void, DrawRectangle, (const float color[4], int l, int t, int r, int b), (override));
     MOCK_METHOD(void, DrawRectangleOutline, (const float color[4], int l, int t, int r, int b), (override));
@@ -165,3 +168,173 @@ TEST(OutputProcessorTest, EvaluateLEDs_IntDatarefWithMinMax) {
     uint8_t bits = processor.EvaluateLEDs(0.0f);
     EXPECT_EQ(bits, IFR1::LEDMask::AP);
 }
+
+TEST(OutputProcessorTest, EvaluateLEDs_ReadsSharedDatarefOncePerFrame) {
+    MockXPlaneSDK mockSdk;
+    DataRefRegistry dataRefs(mockSdk);
+    OutputProcessor processor(mockSdk, dataRefs);
+
+    nlohmann::json config = {
+        {"output", {
+            {"ap", {{"conditions", {{{"dataref", "sim/cockpit/autopilot/autopilot_state"}, {"bit", 1}}}}}},
+            {"hdg", {{"conditions", {{{"dataref", "sim/cockpit/autopilot/autopilot_state"}, {"bit", 2}}}}}},
+            {"nav", {{"conditions", {{{"dataref", "sim/cockpit/autopilot/autopilot_state"}, {"bit", 3}}}}}}
+        }}
+    };
+
+    void* dummyDr = reinterpret_cast<void*>(0x1234);
+    EXPECT_CALL(mockSdk, FindDataRef(StrEq("sim/cockpit/autopilot/autopilot_state"))).WillOnce(Return(dummyDr));
+    EXPECT_CALL(mockSdk, GetDataRefTypes(dummyDr)).WillOnce(Return(1)); // xplmType_Int = 1
+    processor.ParseOutputConfig(config);
+
+    // Three LEDs test the same dataref: one read per frame
+    EXPECT_CALL(mockSdk, GetDatai(dummyDr)).WillOnce(Return(0b0110)).WillOnce(Return(0b1000));
+    dataRefs.BeginFrame();
+    EXPECT_EQ(processor.EvaluateLEDs(0.0f), IFR1::LEDMask::AP | IFR1::LEDMask::HDG);
+    EXPECT_EQ(processor.EvaluateLEDs(0.0f), IFR1::LEDMask::AP | IFR1::LEDMask::HDG);
+    dataRefs.BeginFrame();
+    EXPECT_EQ(processor.EvaluateLEDs(0.0f), IFR1::LEDMask::NAV);
+    dataRefs.EndFrame();
+}
+
+TEST(OutputProcessorTest, EvaluateLEDs_GroupedCondition) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    OutputProcessor processor(mockSdk);
+
+    nlohmann::json config = {
+        {"output", {
+            {"alt", {
+                {"conditions", {
+                    {{"any", {
+                        {{"dataref", "sim/cockpit2/autopilot/altitude_hold_status"}, {"eq", 2}},
+                        {{"dataref", "sim/cockpit2/autopilot/altitude_hold_armed"}, {"eq", 1}}
+                    }}, {"mode", "solid"}}
+                }}
+            }}
+        }}
+    };
+
+    void* holdDr = reinterpret_cast<void*>(0x1);
+    void* armedDr = reinterpret_cast<void*>(0x2);
+    ON_CALL(mockSdk, FindDataRef(StrEq("sim/cockpit2/autopilot/altitude_hold_status"))).WillByDefault(Return(holdDr));
+    ON_CALL(mockSdk, FindDataRef(StrEq("sim/cockpit2/autopilot/altitude_hold_armed"))).WillByDefault(Return(armedDr));
+    ON_CALL(mockSdk, GetDataRefTypes(::testing::_)).WillByDefault(Return(1)); // xplmType_Int = 1
+    processor.ParseOutputConfig(config);
+
+    ON_CALL(mockSdk, GetDatai(holdDr)).WillByDefault(Return(0));
+    ON_CALL(mockSdk, GetDatai(armedDr)).WillByDefault(Return(1));
+    EXPECT_EQ(processor.EvaluateLEDs(0.0f), IFR1::LEDMask::ALT);
+
+    ON_CALL(mockSdk, GetDatai(armedDr)).WillByDefault(Return(0));
+    EXPECT_EQ(processor.EvaluateLEDs(0.0f), IFR1::LEDMask::OFF);
+}
+
+TEST(OutputProcessorTest, EvaluateLEDs_RerunsConditionsOnlyOnChange) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    OutputProcessor processor(mockSdk);
+
+    nlohmann::json config = {
+        {"output", {
+            {"ap", {{"conditions", {{{"dataref", "sim/cockpit/autopilot/autopilot_state"}, {"bit", 1}}}}}},
+            {"alt", {{"conditions", {
+                {{"dataref", "sim/cockpit2/autopilot/altitude_hold_armed"}, {"eq", 1}, {"mode", "blink"}, {"blink-rate", 1.0}}
+            }}}}
+        }}
+    };
+
+    void* stateDr = reinterpret_cast<void*>(0x1);
+    void* armedDr = reinterpret_cast<void*>(0x2);
+    int state = 0b0010;
+    int armed = 0;
+    ON_CALL(mockSdk, FindDataRef(StrEq("sim/cockpit/autopilot/autopilot_state"))).WillByDefault(Return(stateDr));
+    ON_CALL(mockSdk, FindDataRef(StrEq("sim/cockpit2/autopilot/altitude_hold_armed"))).WillByDefault(Return(armedDr));
+    ON_CALL(mockSdk, GetDataRefTypes(::testing::_)).WillByDefault(Return(1)); // xplmType_Int = 1
+    ON_CALL(mockSdk, GetDatai(stateDr)).WillByDefault([&]() { return state; });
+    ON_CALL(mockSdk, GetDatai(armedDr)).WillByDefault([&]() { return armed; });
+    processor.ParseOutputConfig(config);
+
+    EXPECT_EQ(processor.EvaluateLEDs(0.0f), IFR1::LEDMask::AP);
+    EXPECT_EQ(processor.EvaluateLEDs(0.1f), IFR1::LEDMask::AP);
+    EXPECT_EQ(processor.EvaluateLEDs(0.2f), IFR1::LEDMask::AP);
+    EXPECT_EQ(processor.GetEvaluationCount(), 1u);
+
+    // A watched dataref changes
+    state = 0;
+    EXPECT_EQ(processor.EvaluateLEDs(0.3f), IFR1::LEDMask::OFF);
+    EXPECT_EQ(processor.GetEvaluationCount(), 2u);
+
+    // Blinking is rendered from the program, so its edges never re-run the conditions
+    armed = 1;
+    EXPECT_EQ(processor.EvaluateLEDs(0.31f), IFR1::LEDMask::ALT);
+    EXPECT_EQ(processor.EvaluateLEDs(0.4f), IFR1::LEDMask::ALT);
+    EXPECT_EQ(processor.EvaluateLEDs(0.6f), IFR1::LEDMask::OFF);
+    EXPECT_EQ(processor.EvaluateLEDs(0.9f), IFR1::LEDMask::OFF);
+    EXPECT_EQ(processor.EvaluateLEDs(1.1f), IFR1::LEDMask::ALT);
+    EXPECT_EQ(processor.GetEvaluationCount(), 3u);
+}
+
+TEST(OutputProcessorTest, EvaluateProgram_DescribesBlinkRateAndPhase) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    OutputProcessor processor(mockSdk);
+
+    nlohmann::json config = {
+        {"output", {
+            {"ap", {{"conditions", {{{"dataref", "sim/test/on"}, {"eq", 1}}}}}},
+            {"vs", {{"conditions", {
+                {{"dataref", "sim/test/on"}, {"eq", 1}, {"mode", "blink"}, {"blink-rate", 2.0}, {"blink-phase", 0.5}}
+            }}}}
+        }}
+    };
+
+    ON_CALL(mockSdk, FindDataRef(StrEq("sim/test/on"))).WillByDefault(Return(reinterpret_cast<void*>(0x1)));
+    ON_CALL(mockSdk, GetDataRefTypes(::testing::_)).WillByDefault(Return(1)); // xplmType_Int = 1
+    ON_CALL(mockSdk, GetDatai(::testing::_)).WillByDefault(Return(1));
+    processor.ParseOutputConfig(config);
+
+    const LedProgram& program = processor.EvaluateProgram();
+    EXPECT_EQ(program.solid, IFR1::LEDMask::AP);
+    EXPECT_EQ(program.blinking, IFR1::LEDMask::VS);
+    EXPECT_FLOAT_EQ(program.blinkHz[5], 2.0f);
+
+    // 2 Hz starting half a cycle in: dark for the first 0.25 s, then lit
+    EXPECT_EQ(program.Render(0.0), IFR1::LEDMask::AP);
+    EXPECT_EQ(program.Render(0.3), IFR1::LEDMask::AP | IFR1::LEDMask::VS);
+    EXPECT_DOUBLE_EQ(program.NextEdge(0.0), 0.25);
+    EXPECT_DOUBLE_EQ(program.NextEdge(0.3), 0.5);
+}
+
+TEST(OutputProcessorTest, EvaluateLEDs_ReadsArrayElementsWithOneRangedCall) {
+    ::testing::NiceMock<MockXPlaneSDK> mockSdk;
+    OutputProcessor processor(mockSdk);
+
+    // Three elements of one array and a scalar
+    nlohmann::json config = {
+        {"output", {
+            {"ap", {{"conditions", {{{"dataref", "sim/test/bus[0]"}, {"gt", 0}}}}}},
+            {"hdg", {{"conditions", {{{"dataref", "sim/test/bus[1]"}, {"gt", 0}}}}}},
+            {"nav", {{"conditions", {{{"dataref", "sim/test/bus[3]"}, {"gt", 0}}}}}},
+            {"vs", {{"conditions", {{{"dataref", "sim/test/scalar"}, {"eq", 1}}}}}}
+        }}
+    };
+
+    void* busDr = reinterpret_cast<void*>(0x1);
+    void* scalarDr = reinterpret_cast<void*>(0x2);
+    ON_CALL(mockSdk, FindDataRef(StrEq("sim/test/bus"))).WillByDefault(Return(busDr));
+    ON_CALL(mockSdk, FindDataRef(StrEq("sim/test/scalar"))).WillByDefault(Return(scalarDr));
+    ON_CALL(mockSdk, GetDataRefTypes(busDr)).WillByDefault(Return(16)); // xplmType_IntArray = 16
+    ON_CALL(mockSdk, GetDataRefTypes(scalarDr)).WillByDefault(Return(1)); // xplmType_Int = 1
+    ON_CALL(mockSdk, GetDatai(scalarDr)).WillByDefault(Return(1));
+    processor.ParseOutputConfig(config);
+
+    // One window covering elements 0..3, read once per evaluation
+    EXPECT_CALL(mockSdk, GetDataiArrayRange(busDr, ::testing::_, 0, 4))
+        .Times(2)
+        .WillRepeatedly([](void*, int* out, int, int count) {
+            for (int i = 0; i < count; ++i) out[i] = (i == 1) ? 0 : 1;
+            return count;
+        });
+    EXPECT_CALL(mockSdk, GetDataiArray(::testing::_, ::testing::_)).Times(0);
+
+    EXPECT_EQ(processor.EvaluateLEDs(0.0f), IFR1::LEDMask::AP | IFR1::LEDMask::NAV | IFR1::LEDMask::VS);
+    EXPECT_EQ(processor.EvaluateLEDs(0.0f), IFR1::LEDMask::AP | IFR1::LEDMask::NAV | IFR1::LEDMask::VS);
+}
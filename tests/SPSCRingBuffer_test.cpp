@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include "SPSCRingBuffer.h"
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+
+TEST(SPSCRingBufferTest, PushAndPop) {
+    SPSCRingBuffer<int, 4> queue;
+    EXPECT_TRUE(queue.Push(1));
+    EXPECT_TRUE(queue.Push(2));
+
+    EXPECT_EQ(queue.Size(), 2);
+    EXPECT_FALSE(queue.IsEmpty());
+
+    EXPECT_EQ(queue.Pop(), 1);
+    EXPECT_EQ(queue.Pop(), 2);
+    EXPECT_FALSE(queue.Pop().has_value());
+    EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(SPSCRingBufferTest, RejectsNewestWhenFull) {
+    SPSCRingBuffer<int, 4> queue;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.Push(i));
+    }
+    EXPECT_FALSE(queue.Push(99));
+    EXPECT_EQ(queue.DroppedCount(), 1);
+    EXPECT_EQ(queue.Size(), 4);
+
+    // Queued values are untouched by the rejected push
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(queue.Pop(), i);
+    }
+    EXPECT_TRUE(queue.Push(5));
+    EXPECT_EQ(queue.Pop(), 5);
+}
+
+TEST(SPSCRingBufferTest, WrapsAround) {
+    SPSCRingBuffer<int, 4> queue;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(queue.Push(i));
+        ASSERT_TRUE(queue.Push(i + 1000));
+        EXPECT_EQ(queue.Pop(), i);
+        EXPECT_EQ(queue.Pop(), i + 1000);
+    }
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_EQ(queue.DroppedCount(), 0);
+}
+
+TEST(SPSCRingBufferTest, Clear) {
+    SPSCRingBuffer<int, 8> queue;
+    queue.Push(1);
+    queue.Push(2);
+    queue.Clear();
+
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_EQ(queue.Size(), 0);
+    EXPECT_FALSE(queue.Pop().has_value());
+
+    queue.Push(3);
+    EXPECT_EQ(queue.Pop(), 3);
+}
+
+TEST(SPSCRingBufferTest, PreservesOrderAcrossThreads) {
+    SPSCRingBuffer<int, 64> queue;
+    const int count = 100000;
+
+    std::thread producer([&queue, count]() {
+        for (int i = 0; i < count; ++i) {
+            while (!queue.Push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    bool inOrder = true;
+    while (expected < count) {
+        if (auto value = queue.Pop()) {
+            inOrder = inOrder && (*value == expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(inOrder);
+    EXPECT_TRUE(queue.IsEmpty());
+}
+
+// Contention benchmarks: one producer and one consumer hammering the queue at
+// the same time, mirroring the worker thread / flight loop split in
+// DeviceHandler.  They spin for a million items and only print timings, so
+// they are disabled in the normal run; use --gtest_also_run_disabled_tests
+// --gtest_filter='*Benchmark*' to run them.
+namespace {
+
+// The mutex-guarded std::queue the device paths used before the ring buffer,
+// kept as the baseline
+template <typename T>
+class MutexQueue {
+public:
+    bool Push(T value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push(std::move(value));
+        return true;
+    }
+
+    std::optional<T> Pop() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_queue.empty()) return std::nullopt;
+        T value = std::move(m_queue.front());
+        m_queue.pop();
+        return value;
+    }
+
+    bool IsEmpty() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_queue.empty();
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::queue<T> m_queue;
+};
+
+template <typename Queue, typename PushFn>
+double RunContentionBenchmark(Queue& queue, int count, PushFn push) {
+    const auto start = std::chrono::steady_clock::now();
+
+    std::thread producer([&]() {
+        for (int i = 0; i < count; ++i) {
+            while (!push(queue, i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int received = 0;
+    while (received < count) {
+        if (queue.Pop().has_value()) {
+            ++received;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+constexpr int kBenchmarkItems = 1000000;
+
+} // namespace
+
+TEST(QueueContentionBenchmark, DISABLED_MutexQueue) {
+    MutexQueue<int> queue;
+    double ms = RunContentionBenchmark(queue, kBenchmarkItems, [](auto& q, int v) {
+        return q.Push(v);
+    });
+    std::cout << "[          ] MutexQueue: " << kBenchmarkItems << " items in " << ms << " ms" << std::endl;
+    EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(QueueContentionBenchmark, DISABLED_SPSCRingBuffer) {
+    SPSCRingBuffer<int, 256> queue;
+    double ms = RunContentionBenchmark(queue, kBenchmarkItems, [](auto& q, int v) {
+        return q.Push(v);
+    });
+    std::cout << "[          ] SPSCRingBuffer: " << kBenchmarkItems << " items in " << ms << " ms" << std::endl;
+    EXPECT_TRUE(queue.IsEmpty());
+}
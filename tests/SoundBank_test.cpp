@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include "SoundBank.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+class SoundBankTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        testSoundDir = fs::temp_directory_path() / "ifr1flex_test_sounds";
+        fs::create_directories(testSoundDir);
+    }
+
+    void TearDown() override {
+        fs::remove_all(testSoundDir);
+    }
+
+    // Mono 16-bit PCM at 22050 Hz with `dataBytes` bytes of samples
+    static std::string MakeWav(uint32_t dataBytes, uint16_t formatTag = 1) {
+        std::string wav;
+        auto put = [&](const void* p, size_t n) { wav.append(static_cast<const char*>(p), n); };
+        auto put4 = [&](uint32_t v) { put(&v, 4); };
+        auto put2 = [&](uint16_t v) { put(&v, 2); };
+        wav += "RIFF";
+        put4(36 + dataBytes);
+        wav += "WAVEfmt ";
+        put4(16);
+        put2(formatTag);
+        put2(1);
+        put4(22050);
+        put4(22050 * 2);
+        put2(2);
+        put2(16);
+        wav += "data";
+        put4(dataBytes);
+        wav.append(dataBytes, '\x01');
+        return wav;
+    }
+
+    std::string CreateSound(const std::string& filename, const std::string& contents) {
+        const fs::path path = testSoundDir / filename;
+        std::ofstream(path, std::ios::binary) << contents;
+        return path.string();
+    }
+
+    fs::path testSoundDir;
+};
+
+TEST_F(SoundBankTest, ParseWav_ReadsPcm16AndRejectsOtherFormats) {
+    SoundClip clip;
+    std::istringstream pcm(MakeWav(8));
+    ASSERT_TRUE(SoundBank::ParseWav(pcm, clip));
+    EXPECT_EQ(clip.frequency, 22050);
+    EXPECT_EQ(clip.channels, 1);
+    EXPECT_EQ(clip.pcm.size(), 8u);
+
+    SoundClip floatClip;
+    std::istringstream ieeeFloat(MakeWav(8, 3));
+    EXPECT_FALSE(SoundBank::ParseWav(ieeeFloat, floatClip));
+
+    SoundClip truncated;
+    std::istringstream shortFile(MakeWav(8).substr(0, 40));
+    EXPECT_FALSE(SoundBank::ParseWav(shortFile, truncated));
+}
+
+TEST_F(SoundBankTest, Load_ReadsInBackgroundAndSharesOneId) {
+    SoundBank bank;
+    const std::string path = CreateSound("click.wav", MakeWav(64));
+
+    const SoundId id = bank.Load(path);
+    EXPECT_EQ(bank.Load(path), id);
+    ASSERT_TRUE(bank.WaitForLoads(5000));
+
+    auto clip = bank.Acquire(id);
+    ASSERT_NE(clip, nullptr);
+    EXPECT_EQ(clip->pcm.size(), 64u);
+    EXPECT_EQ(bank.GetResidentBytes(), 64u);
+
+    // Once loaded, playing again never needs the file
+    fs::remove(path);
+    EXPECT_NE(bank.Acquire(id), nullptr);
+}
+
+TEST_F(SoundBankTest, Load_MarksUnreadableFilesFailed) {
+    SoundBank bank;
+    const SoundId missing = bank.Load((testSoundDir / "missing.wav").string());
+    const SoundId garbage = bank.Load(CreateSound("garbage.wav", "not a wav file"));
+    ASSERT_TRUE(bank.WaitForLoads(5000));
+
+    EXPECT_EQ(bank.Acquire(missing), nullptr);
+    EXPECT_TRUE(bank.HasFailed(missing));
+    EXPECT_TRUE(bank.HasFailed(garbage));
+    EXPECT_EQ(bank.Acquire(kNoSound), nullptr);
+}
+
+TEST_F(SoundBankTest, Budget_EvictsLeastRecentlyUsedAndReloadsOnDemand) {
+    SoundBank bank(250);
+    const SoundId a = bank.Load(CreateSound("a.wav", MakeWav(100)));
+    ASSERT_TRUE(bank.WaitForLoads(5000));
+    const SoundId b = bank.Load(CreateSound("b.wav", MakeWav(100)));
+    ASSERT_TRUE(bank.WaitForLoads(5000));
+
+    // `a` was used more recently than `b`, so `b` makes way for `c`
+    auto playing = bank.Acquire(b);
+    ASSERT_NE(playing, nullptr);
+    ASSERT_NE(bank.Acquire(a), nullptr);
+    const SoundId c = bank.Load(CreateSound("c.wav", MakeWav(100)));
+    ASSERT_TRUE(bank.WaitForLoads(5000));
+
+    EXPECT_EQ(bank.GetResidentBytes(), 200u);
+    EXPECT_NE(bank.Acquire(c), nullptr);
+    EXPECT_EQ(playing->pcm.size(), 100u);   // A clip in use outlives its eviction
+
+    // The evicted sound is queued again by the miss
+    EXPECT_EQ(bank.Acquire(b), nullptr);
+    ASSERT_TRUE(bank.WaitForLoads(5000));
+    EXPECT_NE(bank.Acquire(b), nullptr);
+    EXPECT_FALSE(bank.HasFailed(b));
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "TimerWheel.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// Half-second ticks keep every time in these tests exact in float
+constexpr float kTick = 0.5f;
+
+std::vector<uint32_t> Advance(TimerWheel& wheel, float now) {
+    std::vector<uint32_t> fired;
+    wheel.Advance(now, [&](uint32_t key) { fired.push_back(key); });
+    std::sort(fired.begin(), fired.end());
+    return fired;
+}
+
+} // namespace
+
+TEST(TimerWheelTest, FiresOnceWhenDue) {
+    TimerWheel wheel(kTick);
+    wheel.Schedule(1, 0.0f, 1.0f);
+    wheel.Schedule(2, 0.0f, 2.0f);
+    EXPECT_EQ(wheel.Size(), 2u);
+
+    EXPECT_TRUE(Advance(wheel, 0.5f).empty());
+    EXPECT_EQ(Advance(wheel, 1.0f), std::vector<uint32_t>{1});
+    EXPECT_TRUE(Advance(wheel, 1.5f).empty());
+    EXPECT_EQ(Advance(wheel, 2.0f), std::vector<uint32_t>{2});
+    EXPECT_TRUE(wheel.Empty());
+}
+
+TEST(TimerWheelTest, TimerBeyondOneTurnWaitsForItsRound) {
+    TimerWheel wheel(kTick);
+    const float turn = TimerWheel::kSlotCount * kTick;
+    wheel.Schedule(1, 0.0f, turn + 1.0f);
+
+    // Its slot comes round once before it is due
+    for (float t = kTick; t < turn + 1.0f; t += kTick) {
+        EXPECT_TRUE(Advance(wheel, t).empty()) << "at " << t;
+    }
+    EXPECT_EQ(Advance(wheel, turn + 1.0f), std::vector<uint32_t>{1});
+}
+
+TEST(TimerWheelTest, LongGapFiresEverythingDue) {
+    TimerWheel wheel(kTick);
+    wheel.Schedule(1, 0.0f, 1.0f);
+    wheel.Schedule(2, 0.0f, 10.0f);
+    wheel.Schedule(3, 0.0f, 100.0f);
+
+    EXPECT_EQ(Advance(wheel, 50.0f), (std::vector<uint32_t>{1, 2}));
+    EXPECT_EQ(wheel.Size(), 1u);
+    EXPECT_EQ(Advance(wheel, 100.0f), std::vector<uint32_t>{3});
+}
+
+TEST(TimerWheelTest, CallbackCanRearmForTheNextAdvance) {
+    TimerWheel wheel(kTick);
+    wheel.Schedule(7, 0.0f, 0.0f);
+
+    int fired = 0;
+    for (float t = 0.5f; t <= 2.0f; t += kTick) {
+        wheel.Advance(t, [&](uint32_t key) {
+            ++fired;
+            // Zero delay still waits for the next tick
+            wheel.Schedule(key, t, 0.0f);
+        });
+    }
+    EXPECT_EQ(fired, 4);
+    EXPECT_EQ(wheel.Size(), 1u);
+
+    wheel.Clear();
+    EXPECT_TRUE(wheel.Empty());
+    EXPECT_TRUE(Advance(wheel, 10.0f).empty());
+}